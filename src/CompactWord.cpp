@@ -0,0 +1,69 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "CompactWord.h"
+
+using namespace SpellChecker;
+
+CompactWord CompactWord::fromWord( const Word& word )
+{
+  return fromWord( word, StringInterner::files().intern( word.fileName ), StringInterner::words().intern( word.text ) );
+}
+// --------------------------------------------------
+
+CompactWord CompactWord::fromWord( const Word& word, StringInterner::Id fileId, StringInterner::Id wordId )
+{
+  CompactWord compact;
+  compact.fileId           = fileId;
+  compact.wordId           = wordId;
+  compact.lineNumber       = uint32_t( qMax( word.lineNumber, 0 ) );
+  compact.columnNumber     = qMin( uint32_t( qMax( word.columnNumber, 0 ) ), MAX_COLUMN );
+  compact.length           = qMin( uint32_t( qMax( word.length, 0 ) ), MAX_LENGTH );
+  compact.inComment        = ( word.inComment == true ) ? 1 : 0;
+  compact.followedByPeriod = ( word.charAfter == QLatin1Char( '.' ) ) ? 1 : 0;
+  return compact;
+}
+// --------------------------------------------------
+
+Word CompactWord::toWord() const
+{
+  Word word;
+  word.text         = text();
+  word.fileName     = fileName();
+  word.lineNumber   = int32_t( lineNumber );
+  word.columnNumber = int32_t( columnNumber );
+  word.length       = int32_t( length );
+  word.inComment    = ( inComment != 0 );
+  word.charAfter    = ( followedByPeriod != 0 ) ? QChar( QLatin1Char( '.' ) ) : QChar();
+  return word;
+}
+// --------------------------------------------------
+
+QString CompactWord::text() const
+{
+  return StringInterner::words().string( wordId );
+}
+// --------------------------------------------------
+
+QString CompactWord::fileName() const
+{
+  return StringInterner::files().string( fileId );
+}
+// --------------------------------------------------
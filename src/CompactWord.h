@@ -0,0 +1,104 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "StringInterner.h"
+#include "Word.h"
+
+#include <memory>
+
+namespace SpellChecker {
+
+/*! \brief The CompactWord class
+ *
+ * Compact record of a misspelled word that is kept by the models for as long
+ * as the mistake exists. A project can have a large number of mistakes, thus
+ * the record does not keep its own strings. The text of the word and the name
+ * of the file are interned in the global StringInterner tables and only their
+ * ids are kept, and the position and flags of the word are packed together.
+ *
+ * The suggestions of a word are not stored on the record, they are kept per
+ * word text in the suggestions cache of the spell checker and retrieved using
+ * ISpellChecker::suggestionsForWord().
+ *
+ * Where the full Word is needed, for example to replace a word in the editor,
+ * the record is expanded using toWord(). */
+class CompactWord
+{
+public:
+  /*! \brief Largest column number that can be stored. */
+  static constexpr uint32_t MAX_COLUMN = ( 1u << 20 ) - 1;
+  /*! \brief Largest word length that can be stored. */
+  static constexpr uint32_t MAX_LENGTH = ( 1u << 10 ) - 1;
+
+  StringInterner::Id fileId = StringInterner::INVALID_ID;
+  StringInterner::Id wordId = StringInterner::INVALID_ID;
+  uint32_t lineNumber       = 0;
+  uint32_t columnNumber     : 20;
+  uint32_t length           : 10;
+  uint32_t inComment        : 1; /*!< If the word comes from a comment or a String Literal. */
+  uint32_t followedByPeriod : 1; /*!< If the next character after the word is a period. */
+
+  CompactWord()
+    : columnNumber( 0 )
+    , length( 0 )
+    , inComment( 0 )
+    , followedByPeriod( 0 ) {}
+
+  /*! \brief Create the compact record for the \a word, interning its text
+   * and file name. */
+  static CompactWord fromWord( const Word& word );
+  /*! \brief Create the compact record for the \a word using the already
+   * interned ids of its file name and text.
+   *
+   * Used when many words of the same file or with the same text are
+   * converted, to only intern the strings once. */
+  static CompactWord fromWord( const Word& word, StringInterner::Id fileId, StringInterner::Id wordId );
+  /*! \brief Expand the record into a full Word. */
+  Word toWord() const;
+  /*! \brief Get the text of the word from the intern table. */
+  QString text() const;
+  /*! \brief Get the file name of the word from the intern table. */
+  QString fileName() const;
+};
+static_assert( sizeof( CompactWord ) == 16, "CompactWord should stay compact" );
+
+/*! \brief Traits for a FlatWordList of CompactWords, keyed on the interned id
+ * of the text of the words. */
+template<>
+struct FlatWordListTraits<CompactWord>
+{
+  using Key = StringInterner::Id;
+  static StringInterner::Id key( const CompactWord& word ) { return word.wordId; }
+  static uint32_t line( const CompactWord& word ) { return word.lineNumber; }
+  static uint32_t column( const CompactWord& word ) { return word.columnNumber; }
+  static uint32_t length( const CompactWord& word ) { return word.length; }
+};
+
+/*! \brief List of compact words, in position order once finalized. */
+using CompactWordList = FlatWordList<CompactWord>;
+/*! \brief Shared, immutable list of compact words.
+ *
+ * The same as for the WordListPtr, the lists do not change once created and
+ * they are shared between the spell checker and the models. */
+using CompactWordListPtr = std::shared_ptr<const CompactWordList>;
+
+} // namespace SpellChecker
@@ -0,0 +1,176 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace SpellChecker {
+
+/*! \brief Concurrent cache from a word to a value.
+ *
+ * The cache is shared between all of the threads that check words, thus
+ * the words are spread over a number of stripes, each with its own hash
+ * and read-write lock. Threads only contend if they access words that
+ * fall in the same stripe at the same time, and readers never block each
+ * other.
+ *
+ * Each stripe is limited to a maximum number of entries. If a stripe is
+ * full it is emptied before a new entry is inserted. This is a very crude
+ * form of eviction, but the cache is only an optimisation and the common
+ * words will get back into the cache very quickly.
+ *
+ * To prevent a value that was calculated before the cache was cleared from
+ * being inserted after the clear, the cache keeps an epoch that is changed
+ * each time that it is cleared. A caller must get the epoch() before it
+ * calculates a value and supply it to insert(), the value will only be
+ * inserted if the epoch did not change in between.
+ *
+ * The cache also keeps counters of the hits and misses so that its
+ * effectiveness can be reported. */
+template<typename T>
+class ConcurrentWordCache
+{
+  /*! \brief Deleted copy constructor */
+  ConcurrentWordCache( const ConcurrentWordCache& ) = delete;
+  /*! \brief Deleted assignment operator */
+  ConcurrentWordCache& operator=( const ConcurrentWordCache& ) = delete;
+
+public:
+  /*! \brief Number of stripes, must be a power of 2. */
+  static constexpr uint32_t STRIPE_COUNT = 32;
+  static_assert( ( STRIPE_COUNT & ( STRIPE_COUNT - 1 ) ) == 0, "STRIPE_COUNT must be a power of 2" );
+
+  /*! \brief Constructor
+   * \param maxEntriesPerStripe Maximum number of entries in each stripe before
+   *        the stripe gets emptied. */
+  explicit ConcurrentWordCache( int32_t maxEntriesPerStripe = 4096 )
+    : d_maxEntriesPerStripe( maxEntriesPerStripe )
+  {}
+
+  /*! \brief Get the current epoch of the cache.
+   *
+   * The epoch must be retrieved before a value is calculated that will be
+   * inserted into the cache using insert(). */
+  uint64_t epoch() const
+  {
+    return d_epoch.load( std::memory_order_acquire );
+  }
+
+  /*! \brief Find the value for the given \a word.
+   * \param[in] word Word to look up.
+   * \param[out] value Value of the word if it was found.
+   * \return True if the word was found in the cache. */
+  bool find( const QString& word, T& value ) const
+  {
+    const Stripe& stripe = stripeFor( word );
+    {
+      QReadLocker lock( &stripe.lock );
+      auto iter = stripe.hash.constFind( word );
+      if( iter != stripe.hash.constEnd() ) {
+        value = iter.value();
+        d_hits.fetch_add( 1, std::memory_order_relaxed );
+        return true;
+      }
+    }
+    d_misses.fetch_add( 1, std::memory_order_relaxed );
+    return false;
+  }
+
+  /*! \brief Insert a value for the given \a word.
+   *
+   * The value is only inserted if the cache was not cleared since \a epoch
+   * was retrieved.
+   * \param[in] word Word that the value is for.
+   * \param[in] value Value to store for the word.
+   * \param[in] epoch Epoch retrieved before the value was calculated. */
+  void insert( const QString& word, const T& value, uint64_t epoch )
+  {
+    Stripe& stripe = stripeFor( word );
+    QWriteLocker lock( &stripe.lock );
+    /* The epoch is checked while holding the lock. clear() changes the epoch
+     * before it empties the stripes, thus if the epoch still matches here the
+     * stripe was not yet emptied and will be emptied after this insert. */
+    if( epoch != d_epoch.load( std::memory_order_acquire ) ) {
+      return;
+    }
+    if( stripe.hash.size() >= d_maxEntriesPerStripe ) {
+      stripe.hash.clear();
+    }
+    stripe.hash.insert( word, value );
+  }
+
+  /*! \brief Clear all entries in the cache.
+   *
+   * Values that are being calculated while the cache is cleared will not be
+   * inserted into the cache since the epoch changes. */
+  void clear()
+  {
+    d_epoch.fetch_add( 1, std::memory_order_acq_rel );
+    for( Stripe& stripe: d_stripes ) {
+      QWriteLocker lock( &stripe.lock );
+      stripe.hash.clear();
+    }
+  }
+
+  /*! \brief Number of lookups that were found in the cache. */
+  uint64_t hits() const
+  {
+    return d_hits.load( std::memory_order_relaxed );
+  }
+
+  /*! \brief Number of lookups that were not found in the cache. */
+  uint64_t misses() const
+  {
+    return d_misses.load( std::memory_order_relaxed );
+  }
+
+private:
+  /*! \brief A stripe of the cache with its own lock. */
+  struct Stripe
+  {
+    mutable QReadWriteLock lock;
+    QHash<QString, T> hash;
+  };
+
+  Stripe& stripeFor( const QString& word )
+  {
+    return d_stripes[qHash( word ) & ( STRIPE_COUNT - 1 )];
+  }
+
+  const Stripe& stripeFor( const QString& word ) const
+  {
+    return d_stripes[qHash( word ) & ( STRIPE_COUNT - 1 )];
+  }
+
+  std::array<Stripe, STRIPE_COUNT> d_stripes;
+  const int32_t d_maxEntriesPerStripe;
+  std::atomic<uint64_t> d_epoch{ 0 };
+  mutable std::atomic<uint64_t> d_hits{ 0 };
+  mutable std::atomic<uint64_t> d_misses{ 0 };
+};
+
+} // namespace SpellChecker
@@ -0,0 +1,315 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace SpellChecker {
+
+/*! \brief Traits used by the FlatWordList to get the key and position of
+ * a word.
+ *
+ * A specialisation must be given for each type of word that is stored in a
+ * FlatWordList. It must define the \a Key type and the static functions
+ * key(), line(), column() and length(). */
+template<typename T>
+struct FlatWordListTraits;
+
+/*! \brief The FlatWordList class
+ *
+ * Container for the words of a file. The occurrences are stored in one
+ * contiguous vector, sorted by their position in the file. A side index maps
+ * each unique word to the range of its occurrences, so that all occurrences
+ * of a word can be found without searching through all of the words.
+ *
+ * The list is filled using append() and can be changed in place with
+ * mutableWords() while it is built. Once it is complete, finalize() sorts
+ * the words by position and builds the index. Only a finalized list supports
+ * the lookups keys(), contains(), occurrences() and wordAt(). Any change to
+ * the list after finalize() invalidates the index and the list must be
+ * finalized again.
+ *
+ * Lists are shared between threads once they are finalized, the lookups do
+ * not change the list and are safe to use from multiple threads. */
+template<typename T>
+class FlatWordList
+{
+public:
+  using Traits         = FlatWordListTraits<T>;
+  using Key            = typename Traits::Key;
+  using value_type     = T;
+  using iterator       = typename QVector<T>::iterator;
+  using const_iterator = typename QVector<T>::const_iterator;
+  using Iterator       = iterator;
+  using ConstIterator  = const_iterator;
+
+  /*! \brief Range over the occurrences of a single word, in position order. */
+  class Occurrences
+  {
+  public:
+    class const_iterator
+    {
+    public:
+      const_iterator( const T* words, const int32_t* index )
+        : d_words( words )
+        , d_index( index ) {}
+      const T& operator*() const { return d_words[*d_index]; }
+      const T* operator->() const { return &d_words[*d_index]; }
+      const_iterator& operator++() { ++d_index; return *this; }
+      bool operator==( const const_iterator& other ) const { return d_index == other.d_index; }
+      bool operator!=( const const_iterator& other ) const { return d_index != other.d_index; }
+    private:
+      const T* d_words;
+      const int32_t* d_index;
+    };
+
+    Occurrences()
+      : d_words( nullptr )
+      , d_begin( nullptr )
+      , d_end( nullptr ) {}
+    Occurrences( const T* words, const int32_t* begin, const int32_t* end )
+      : d_words( words )
+      , d_begin( begin )
+      , d_end( end ) {}
+    const_iterator begin() const { return const_iterator( d_words, d_begin ); }
+    const_iterator end() const { return const_iterator( d_words, d_end ); }
+    int32_t count() const { return int32_t( d_end - d_begin ); }
+    bool isEmpty() const { return d_begin == d_end; }
+  private:
+    const T* d_words;
+    const int32_t* d_begin;
+    const int32_t* d_end;
+  };
+
+  FlatWordList() = default;
+
+  /*! \brief Append the \a word at the end of the list. */
+  void append( const T& word )
+  {
+    d_finalized = false;
+    d_words.append( word );
+  }
+  /*! \brief Append the \a word at the end of the list. */
+  void append( T&& word )
+  {
+    d_finalized = false;
+    d_words.append( std::move( word ) );
+  }
+  /*! \brief Append all words of the \a other list at the end of the list. */
+  void append( const FlatWordList& other )
+  {
+    if( other.isEmpty() == true ) {
+      return;
+    }
+    d_finalized = false;
+    d_words.append( other.d_words );
+  }
+  /*! \brief Reserve space for \a size words. */
+  void reserve( qsizetype size ) { d_words.reserve( size ); }
+  /*! \brief Remove all of the words. */
+  void clear()
+  {
+    d_words.clear();
+    clearIndex();
+    d_finalized = true;
+  }
+
+  qsizetype size() const { return d_words.size(); }
+  qsizetype count() const { return d_words.size(); }
+  bool isEmpty() const { return d_words.isEmpty(); }
+  bool empty() const { return d_words.isEmpty(); }
+  const T& at( qsizetype index ) const { return d_words.at( index ); }
+  const T& first() const { return d_words.first(); }
+
+  /*! \brief Iterators over the words, in position order once finalized.
+   *
+   * Iterating never changes the list, use mutableWords() to change the words
+   * in place. */
+  const_iterator begin() const { return d_words.cbegin(); }
+  const_iterator end() const { return d_words.cend(); }
+  const_iterator cbegin() const { return d_words.cbegin(); }
+  const_iterator cend() const { return d_words.cend(); }
+  const_iterator constBegin() const { return d_words.cbegin(); }
+  const_iterator constEnd() const { return d_words.cend(); }
+
+  /*! \brief Get the words to change them in place.
+   *
+   * The words might be changed, thus this invalidates the index and the list
+   * must be finalized again before it is used for lookups. */
+  QVector<T>& mutableWords()
+  {
+    d_finalized = false;
+    return d_words;
+  }
+  /*! \brief Erase the words in the range [first, last). */
+  iterator erase( const_iterator first, const_iterator last )
+  {
+    d_finalized = false;
+    return d_words.erase( first, last );
+  }
+  /*! \brief Remove all words for which the \a predicate returns true.
+   *
+   * The words are removed in one pass over the list, erasing words one at a
+   * time from a vector would move all words after it for each word.
+   * \return The number of words removed. */
+  template<typename Predicate>
+  qsizetype removeIf( Predicate predicate )
+  {
+    const auto newEnd     = std::remove_if( d_words.begin(), d_words.end(), predicate );
+    const qsizetype count = qsizetype( d_words.end() - newEnd );
+    if( count != 0 ) {
+      d_words.erase( newEnd, d_words.end() );
+      d_finalized = false;
+    }
+    return count;
+  }
+
+  /*! \brief Sort the words by position and build the index of the words.
+   *
+   * This must be called once the list is complete, before it is handed to
+   * other parts of the plugin. Calling it on a finalized list does nothing. */
+  void finalize()
+  {
+    if( d_finalized == true ) {
+      return;
+    }
+    std::stable_sort( d_words.begin(), d_words.end(), []( const T& lhs, const T& rhs ) {
+      if( Traits::line( lhs ) != Traits::line( rhs ) ) {
+        return Traits::line( lhs ) < Traits::line( rhs );
+      }
+      return Traits::column( lhs ) < Traits::column( rhs );
+    } );
+    buildIndex();
+    d_finalized = true;
+  }
+  /*! \brief Check if the list was finalized since it was last changed. */
+  bool isFinalized() const { return d_finalized; }
+
+  /*! \brief Get the unique words in the list, in the order of their first
+   * occurrence. */
+  const QVector<Key>& keys() const
+  {
+    Q_ASSERT( d_finalized == true );
+    return d_keys;
+  }
+  /*! \brief Check if the list contains an occurrence of the word with the
+   * given \a key. */
+  bool contains( const Key& key ) const
+  {
+    Q_ASSERT( d_finalized == true );
+    return d_keyIndex.contains( key );
+  }
+  /*! \brief Get all occurrences of the word with the given \a key. */
+  Occurrences occurrences( const Key& key ) const
+  {
+    Q_ASSERT( d_finalized == true );
+    const auto iter = d_keyIndex.constFind( key );
+    if( iter == d_keyIndex.constEnd() ) {
+      return Occurrences();
+    }
+    const QPair<int32_t, int32_t>& range = d_ranges.at( iter.value() );
+    const int32_t* index                 = d_occurrenceIndex.constData();
+    return Occurrences( d_words.constData(), index + range.first, index + range.second );
+  }
+  /*! \brief Get the word that covers the given \a line and \a column.
+   *
+   * The words are sorted by position, thus the line is found using a binary
+   * search and only the words on that line are checked.
+   * \return The word, or nullptr if there is no word at the position. */
+  const T* wordAt( int32_t line, int32_t column ) const
+  {
+    Q_ASSERT( d_finalized == true );
+    auto iter = std::lower_bound( d_words.cbegin(), d_words.cend(), line, []( const T& word, int32_t value ) {
+      return int32_t( Traits::line( word ) ) < value;
+    } );
+    for( ; ( iter != d_words.cend() ) && ( int32_t( Traits::line( *iter ) ) == line ); ++iter ) {
+      const int32_t wordColumn = int32_t( Traits::column( *iter ) );
+      if( wordColumn > column ) {
+        break;
+      }
+      if( ( wordColumn + int32_t( Traits::length( *iter ) ) ) >= column ) {
+        return &( *iter );
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  void clearIndex()
+  {
+    d_keys.clear();
+    d_keyIndex.clear();
+    d_ranges.clear();
+    d_occurrenceIndex.clear();
+  }
+
+  /*! \brief Build the side index of the words.
+   *
+   * The occurrences of each word are grouped together in the occurrence
+   * index, and a range into the index is kept for each unique word. */
+  void buildIndex()
+  {
+    clearIndex();
+    const int32_t wordCount = int32_t( d_words.size() );
+    /* Count the occurrences of each word, and remember the slot of each
+     * word so that the key does not need to be looked up again. */
+    QVector<int32_t> wordSlots( wordCount );
+    for( int32_t index = 0; index < wordCount; ++index ) {
+      const Key& key = Traits::key( d_words.at( index ) );
+      auto iter      = d_keyIndex.find( key );
+      if( iter == d_keyIndex.end() ) {
+        iter = d_keyIndex.insert( key, int32_t( d_keys.size() ) );
+        d_keys.append( key );
+        d_ranges.append( qMakePair( 0, 0 ) );
+      }
+      wordSlots[index] = iter.value();
+      ++d_ranges[iter.value()].second;
+    }
+    /* Turn the counts into the start of each range. The end of each range is
+     * used as the insert position while the index gets filled. */
+    int32_t offset = 0;
+    for( QPair<int32_t, int32_t>& range: d_ranges ) {
+      const int32_t occurrences = range.second;
+      range.first  = offset;
+      range.second = offset;
+      offset      += occurrences;
+    }
+    d_occurrenceIndex.resize( wordCount );
+    for( int32_t index = 0; index < wordCount; ++index ) {
+      d_occurrenceIndex[d_ranges[wordSlots.at( index )].second++] = index;
+    }
+  }
+
+  QVector<T> d_words;
+  QVector<Key> d_keys;
+  QHash<Key, int32_t> d_keyIndex;
+  QVector<QPair<int32_t, int32_t>> d_ranges;
+  QVector<int32_t> d_occurrenceIndex;
+  bool d_finalized = true;
+};
+
+} // namespace SpellChecker
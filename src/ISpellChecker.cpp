@@ -18,7 +18,9 @@
 ** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
 ****************************************************************************/
 
+#include "CompactWord.h"
 #include "ISpellChecker.h"
+#include "SuggestionService.h"
 #include "Word.h"
 
 // #define BENCH_TIME
@@ -26,13 +28,129 @@
 #include <QElapsedTimer>
 #endif /* BENCH_TIME */
 
+#include <optional>
+
 using namespace SpellChecker;
 
-SpellCheckProcessor::SpellCheckProcessor( ISpellChecker* spellChecker, const QString& fileName, const WordList& wordList, const WordList& previousMistakes )
+namespace {
+/*! \brief Default time in milliseconds to wait for suggestions. */
+constexpr int32_t DEFAULT_SUGGESTIONS_TIMEOUT = 250;
+} // namespace
+
+ISpellChecker::ISpellChecker()
+  : d_suggestionService( new SuggestionService( this ) )
+  , d_suggestionsTimeout( DEFAULT_SUGGESTIONS_TIMEOUT )
+{
+  connect( d_suggestionService, &SuggestionService::suggestionsReady, this, &ISpellChecker::suggestionsReady );
+}
+// --------------------------------------------------
+
+ISpellChecker::~ISpellChecker()
+{
+  delete d_suggestionService;
+}
+// --------------------------------------------------
+
+bool ISpellChecker::isSpellingMistakeCached( const QString& word ) const
+{
+  bool spellingMistake = false;
+  if( d_verdictCache.find( word, spellingMistake ) == true ) {
+    return spellingMistake;
+  }
+  /* Get the epoch before the word is checked so that a verdict that was
+   * calculated while the cache was invalidated does not get added. */
+  const uint64_t epoch = d_verdictCache.epoch();
+  spellingMistake = isSpellingMistake( word );
+  d_verdictCache.insert( word, spellingMistake, epoch );
+  return spellingMistake;
+}
+// --------------------------------------------------
+
+void ISpellChecker::checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const
+{
+  mistakes = QBitArray( words.size() );
+  for( qsizetype index = 0; index < words.size(); ++index ) {
+    if( isSpellingMistake( words.at( index ).toString() ) == true ) {
+      mistakes.setBit( index );
+    }
+  }
+}
+// --------------------------------------------------
+
+void ISpellChecker::checkWordsCached( const QStringList& words, QBitArray& mistakes ) const
+{
+  mistakes = QBitArray( words.size() );
+  QVector<QStringView> uncached;
+  QVector<qsizetype> uncachedIndexes;
+  bool spellingMistake = false;
+  for( qsizetype index = 0; index < words.size(); ++index ) {
+    if( d_verdictCache.find( words.at( index ), spellingMistake ) == true ) {
+      mistakes.setBit( index, spellingMistake );
+    } else {
+      uncached.append( words.at( index ) );
+      uncachedIndexes.append( index );
+    }
+  }
+  if( uncached.isEmpty() == true ) {
+    return;
+  }
+
+  const uint64_t epoch = d_verdictCache.epoch();
+  QBitArray uncachedMistakes;
+  checkWords( uncached, uncachedMistakes );
+  for( qsizetype index = 0; index < uncachedIndexes.size(); ++index ) {
+    const qsizetype wordIndex = uncachedIndexes.at( index );
+    spellingMistake = uncachedMistakes.testBit( index );
+    mistakes.setBit( wordIndex, spellingMistake );
+    d_verdictCache.insert( words.at( wordIndex ), spellingMistake, epoch );
+  }
+}
+// --------------------------------------------------
+
+const ISpellChecker::VerdictCache& ISpellChecker::verdictCache() const
+{
+  return d_verdictCache;
+}
+// --------------------------------------------------
+
+bool ISpellChecker::suggestionsForWord( const QString& word, QStringList& suggestions, int32_t timeout ) const
+{
+  if( timeout < 0 ) {
+    timeout = d_suggestionsTimeout.load();
+  }
+  return d_suggestionService->suggestionsForWord( word, timeout, suggestions );
+}
+// --------------------------------------------------
+
+bool ISpellChecker::cachedSuggestionsForWord( const QString& word, QStringList& suggestions ) const
+{
+  return d_suggestionService->cache().find( word, suggestions );
+}
+// --------------------------------------------------
+
+void ISpellChecker::setSuggestionsTimeout( int32_t timeout )
+{
+  d_suggestionsTimeout.store( timeout );
+}
+// --------------------------------------------------
+
+void ISpellChecker::invalidateCaches()
+{
+  d_verdictCache.clear();
+  d_suggestionService->cache().clear();
+}
+// --------------------------------------------------
+
+void ISpellChecker::stopBackgroundWork()
+{
+  d_suggestionService->stop();
+}
+// --------------------------------------------------
+
+SpellCheckProcessor::SpellCheckProcessor( ISpellChecker* spellChecker, const QString& fileName, WordListPtr wordList )
   : d_spellChecker( spellChecker )
   , d_fileName( fileName )
-  , d_wordList( wordList )
-  , d_previousMistakes( previousMistakes )
+  , d_wordList( std::move( wordList ) )
 {}
 // --------------------------------------------------
 
@@ -40,91 +158,75 @@ SpellCheckProcessor::~SpellCheckProcessor()
 {}
 // --------------------------------------------------
 
-void SpellCheckProcessor::process( QPromise<WordList>& promise )
+void SpellCheckProcessor::process( QPromise<CompactWordListPtr>& promise )
 {
 #ifdef BENCH_TIME
   QElapsedTimer timer;
   timer.start();
 #endif /* BENCH_TIME */
-  WordListConstIter misspelledIter;
-  WordListConstIter prevMisspelledIter;
-  Word misspelledWord;
-  WordList misspelledWords;
-  WordList words             = d_wordList;
-  WordListConstIter wordIter = words.constBegin();
-  bool spellingMistake;
-  promise.setProgressRange( 0, words.count() + 1 );
-  while( wordIter != d_wordList.constEnd() ) {
-    /* Get the word at the current iterator position.
-     * After this is done, move the iterator to the next position and
-     * increment the progress value. This is done so that one can call
-     * 'continue' anywhere after this in the loop without having to worry
-     * about advancing the iterator since this will already be done and
-     * correct for the next iteration. */
-    misspelledWord = ( *wordIter );
-    ++wordIter;
-    promise.setProgressValue( promise.future().progressValue() + 1 );
+  /* The same word often appears many times in a file. Each distinct word is
+   * only checked once and the verdict is then applied to all of its
+   * occurrences.
+   *
+   * The words are checked in chunks using the batch interface of the spell
+   * checker. This reduces the overhead per word for the spell checker, while
+   * still allowing the future to be cancelled and the progress to be updated
+   * regularly. */
+  constexpr qsizetype CHUNK_SIZE = 256;
+  CompactWordList misspelledWords;
+  QBitArray chunkMistakes;
+  const StringInterner::Id fileId = StringInterner::files().intern( d_fileName );
+  const WordList& wordList        = *d_wordList;
+  const QStringList distinctWords = wordList.keys();
+  promise.setProgressRange( 0, distinctWords.size() + 1 );
+  for( qsizetype chunkStart = 0; chunkStart < distinctWords.size(); chunkStart += CHUNK_SIZE ) {
+    const QStringList chunkText = distinctWords.mid( chunkStart, CHUNK_SIZE );
     /* Check if the future was cancelled */
     if( promise.isCanceled() == true ) {
       return;
     }
-    spellingMistake = d_spellChecker->isSpellingMistake( misspelledWord.text );
-    /* Check to see if the char after the word is a period. If it is,
-     * add the period to the word an see if it passes the checker. */
-    if( ( spellingMistake == true )
-        && ( misspelledWord.charAfter == QLatin1Char( '.' ) ) ) {
-      /* Recheck the word with the period added */
-      spellingMistake = d_spellChecker->isSpellingMistake( misspelledWord.text + QLatin1Char( '.' ) );
-    }
+    d_spellChecker->checkWordsCached( chunkText, chunkMistakes );
+    promise.setProgressValue( promise.future().progressValue() + chunkText.size() );
 
-    if( spellingMistake == true ) {
-      /* The word is a spelling mistake, check if the word was a mistake
-       * the previous time that this file was processed. If it was the
-       * suggestions can be reused without having to get the suggestions
-       * through the spell checker since this is slow compared to the rest
-       * of the processing. */
-      prevMisspelledIter = d_previousMistakes.constFind( misspelledWord.text );
-      if( prevMisspelledIter != d_previousMistakes.constEnd() ) {
-        misspelledWord.suggestions = ( *prevMisspelledIter ).suggestions;
-        misspelledWords.append( misspelledWord );
+    for( qsizetype index = 0; index < chunkText.size(); ++index ) {
+      if( chunkMistakes.testBit( index ) == false ) {
         continue;
       }
-      /* The word was not in the previous iteration, search for the word
-       * in the list of words that were already checked in this iteration
-       * and identified as spelling mistakes. If there are words that are
-       * repeated and misspelled, this can reduce the time to process
-       * the file since the time to get suggestions is rather slow.
-       * If there are no repeating mistakes then this might add unneeded
-       * overhead. */
-      misspelledIter = misspelledWords.constFind( misspelledWord.text );
-      if( misspelledIter != misspelledWords.constEnd() ) {
-        misspelledWord.suggestions = ( *misspelledIter ).suggestions;
-        /* Add the word to the local list of misspelled words. */
-        misspelledWords.append( misspelledWord );
-        continue;
-      }
-
-      /* Another checkpoint before we go into the SpellChecker to check for mistakes */
-      if( promise.isCanceled() == true ) {
-        return;
+      const QString& text = chunkText.at( index );
+      /* Words followed by a period are rechecked with the period added, this
+       * is only done once for the word, and only if needed. */
+      std::optional<bool> mistakeWithPeriod;
+      const StringInterner::Id wordId = StringInterner::words().intern( text );
+      for( const Word& word: wordList.occurrences( text ) ) {
+        if( word.charAfter == QLatin1Char( '.' ) ) {
+          if( mistakeWithPeriod.has_value() == false ) {
+            mistakeWithPeriod = d_spellChecker->isSpellingMistakeCached( text + QLatin1Char( '.' ) );
+          }
+          if( mistakeWithPeriod.value() == false ) {
+            continue;
+          }
+        }
+        /* The word is a spelling mistake. Suggestions for the word are not
+         * retrieved here, they are only retrieved when needed. */
+        misspelledWords.append( CompactWord::fromWord( word, fileId, wordId ) );
       }
-      /* At this point the word is a mistake for the first time. It was neither
-       * a mistake in the previous pass of the file nor did the word occur previously
-       * in this file, use the spell checker to get the suggestions for the word. */
-      d_spellChecker->getSuggestionsForWord( misspelledWord.text, misspelledWord.suggestions );
-      /* Add the word to the local list of misspelled words. */
-      misspelledWords.append( misspelledWord );
     }
   }
 #ifdef BENCH_TIME
   qDebug() << "File: " << d_fileName
            << "\n  - time : " << timer.elapsed()
-           << "\n  - count: " << misspelledWords.size();
+           << "\n  - words: " << wordList.size() << "(" << distinctWords.size() << "distinct)"
+           << "\n  - count: " << misspelledWords.size()
+           << "\n  - cache: " << d_spellChecker->verdictCache().hits() << "hits,"
+           << d_spellChecker->verdictCache().misses() << "misses";
 #endif /* BENCH_TIME */
 
   if( promise.isCanceled() == true ) {
     return;
   }
-  promise.addResult( misspelledWords );
+  /* The mistakes were added per word, sort them by position before they are
+   * shared with the models. */
+  misspelledWords.finalize();
+  promise.addResult( std::make_shared<const CompactWordList>( std::move( misspelledWords ) ) );
 }
 // --------------------------------------------------
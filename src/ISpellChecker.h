@@ -20,8 +20,13 @@
 
 #pragma once
 
+#include "CompactWord.h"
+#include "ConcurrentWordCache.h"
 #include "Word.h"
 
+#include <atomic>
+
+#include <QBitArray>
 #include <QFuture>
 #include <QObject>
 #include <QSettings>
@@ -29,6 +34,7 @@
 namespace SpellChecker {
 
 class IOptionsWidget;
+class SuggestionService;
 
 /*! \brief The ISpellChecker Interface
  *
@@ -39,8 +45,8 @@ class ISpellChecker
 {
   Q_OBJECT
 public:
-  ISpellChecker() {}
-  virtual ~ISpellChecker() {}
+  ISpellChecker();
+  virtual ~ISpellChecker();
 
   /*! \brief Get the name of the Spell Checker.
    * \return String name of the spell checker.
@@ -51,6 +57,18 @@ public:
    * \return True if the word is a spelling mistake.
    */
   virtual bool isSpellingMistake( const QString& word ) const = 0;
+  /*! \brief Query a batch of words for spelling mistakes.
+   *
+   * The default implementation calls isSpellingMistake() for each word.
+   * Implementations should override this function if they can check a
+   * number of words cheaper than calling isSpellingMistake() for each,
+   * for example by only taking locks and setting up buffers once for the
+   * whole batch.
+   * \param[in] words Words that must be checked. The views are only valid
+   *                  for the duration of the call.
+   * \param[out] mistakes Resized to the number of \a words, with the bit for
+   *                  each word that is a spelling mistake set. */
+  virtual void checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const;
   /*! \brief Get suggestions for a given word.
    * \param[in] word Misspelled word that suggestions for correct spellings
    *                  are required.
@@ -84,6 +102,91 @@ public:
    * \return Pointer to the options widget.
    */
   virtual IOptionsWidget* optionsWidget() = 0;
+
+  /*! \brief Alias for the cache of verdicts of words. */
+  using VerdictCache = ConcurrentWordCache<bool>;
+  /*! \brief Query if a given word is a spelling mistake, using the verdict cache.
+   *
+   * Most words that get checked are correct and repeat a lot between files.
+   * This function first checks the verdict cache of the spell checker for the
+   * word and only calls isSpellingMistake() if the word is not in the cache.
+   * The verdict is then added to the cache for the next time that the word
+   * is checked.
+   * \param[in] word Word that must be checked.
+   * \return True if the word is a spelling mistake. */
+  bool isSpellingMistakeCached( const QString& word ) const;
+  /*! \brief Query a batch of words for spelling mistakes, using the verdict cache.
+   *
+   * All words that are not in the verdict cache are checked in one call to
+   * checkWords() and their verdicts are then added to the cache.
+   * \param[in] words Words that must be checked.
+   * \param[out] mistakes Resized to the number of \a words, with the bit for
+   *                  each word that is a spelling mistake set. */
+  void checkWordsCached( const QStringList& words, QBitArray& mistakes ) const;
+  /*! \brief Get the verdict cache of the spell checker.
+   *
+   * This is mainly to get the hit and miss counters of the cache. */
+  const VerdictCache& verdictCache() const;
+
+  /*! \brief Get the suggestions for a misspelled word, on demand.
+   *
+   * Getting suggestions is by far the slowest operation of a spell checker,
+   * and most of the suggestions are never looked at. For this reason the
+   * suggestions are not calculated when words are checked, but only when they
+   * are needed by calling this function. The suggestions are added to a
+   * suggestions cache so that they are only calculated once.
+   *
+   * The suggestions are retrieved by a SuggestionService in the background
+   * and the caller only waits for them for a limited time. If the time runs
+   * out the word is pending, and the suggestionsReady() signal is emitted
+   * once the suggestions are known.
+   * \param[in] word Misspelled word that suggestions are needed for.
+   * \param[out] suggestions List of suggested correct spellings for the \a word.
+   * \param[in] timeout Time in milliseconds to wait for the suggestions. If
+   *              negative, the time set using setSuggestionsTimeout() is used.
+   * \return True if the suggestions are known, false if they are pending. */
+  bool suggestionsForWord( const QString& word, QStringList& suggestions, int32_t timeout = -1 ) const;
+  /*! \brief Get the suggestions for a word only if they are already known.
+   *
+   * This does not calculate the suggestions if they are not in the cache, and
+   * is meant for places that must stay fast, like the tooltip of a mistake.
+   * \param[in] word Misspelled word that suggestions are needed for.
+   * \param[out] suggestions Cached suggestions for the \a word.
+   * \return True if the suggestions were in the cache. */
+  bool cachedSuggestionsForWord( const QString& word, QStringList& suggestions ) const;
+  /*! \brief Set the time in milliseconds that suggestionsForWord() waits for
+   * the suggestions of a word by default. */
+  void setSuggestionsTimeout( int32_t timeout );
+
+signals:
+  /*! \brief Signal emitted when the suggestions for a word that was pending
+   * are known.
+   * \param word Word that the suggestions are known for. */
+  void suggestionsReady( const QString& word );
+  /*! \brief Signal emitted when the dictionary of the spell checker was
+   * replaced while the application is running.
+   *
+   * All files must be checked again after this signal. */
+  void dictionaryReloaded();
+
+protected:
+  /*! \brief Invalidate all cached results of the spell checker.
+   *
+   * Implementations must call this function each time that the set of words
+   * that are considered correct changes, for example when a word is added or
+   * ignored or when the dictionary changes. */
+  void invalidateCaches();
+  /*! \brief Stop all work that is done in the background for the spell checker.
+   *
+   * Background work, like getting suggestions, calls into the implementation.
+   * For this reason implementations must call this function at the start of
+   * their destructors. */
+  void stopBackgroundWork();
+
+private:
+  mutable VerdictCache d_verdictCache;
+  SuggestionService* const d_suggestionService;
+  std::atomic<int32_t> d_suggestionsTimeout;
 };
 
 /*! \brief The SpellCheckProcessor class
@@ -96,12 +199,13 @@ public:
  *
  * The processor uses the spell checker that is set on the application
  * to check the words that were extracted from the file and check them
- * for spelling mistakes. To speed up the checking the processor also takes
- * in the list of previous mistakes extracted from the file. This is done
- * since the suggestions for misspelled words can be reused without having to
- * ask the spell checker for suggestions each time for repeating words.
- * The chance that a word repeats in a file is big for different passes and the
- * time for a spell checker to get suggestions can be rather slow.
+ * for spelling mistakes. The processor does not get suggestions for the
+ * misspelled words, since that is slow and most of them are never looked at.
+ * Suggestions are retrieved on demand using
+ * ISpellChecker::suggestionsForWord().
+ *
+ * The misspelled words are reported as compact records, since they are kept
+ * by the models for as long as the mistakes exist.
  *
  * This process can be cancelled by cancelling the future. */
 class SpellCheckProcessor
@@ -116,17 +220,15 @@ public:
    *      must be thread safe.
    * \param[in] fileName Name of the file that the given words to be checked belongs to.
    * \param[in] wordList Words that must be checked for possible spelling mistakes.
-   * \param[in] previousMistakes List of words that were identified as spelling mistakes in
-   *      the previous processing run of the current file.*/
-  SpellCheckProcessor( ISpellChecker* spellChecker, const QString& fileName, const WordList& wordList, const WordList& previousMistakes );
+   *      The list is shared with the parser, it is not copied. */
+  SpellCheckProcessor( ISpellChecker* spellChecker, const QString& fileName, WordListPtr wordList );
   ~SpellCheckProcessor();
   /*! Function that will run in the background/thread. */
-  void process(QPromise<WordList>& promise );
+  void process( QPromise<CompactWordListPtr>& promise );
 protected:
   ISpellChecker* d_spellChecker;
   QString  d_fileName;
-  WordList d_wordList;
-  WordList d_previousMistakes;
+  WordListPtr d_wordList;
 };
 
 } // namespace SpellChecker
@@ -26,7 +26,12 @@
 #include "cppdocumentprocessor.h"
 #include "cppparserconstants.h"
 #include "cppparseroptionspage.h"
+#include "cppidentifierindex.h"
+#include "cppinflightcontroller.h"
 #include "cppparsersettings.h"
+#include "cpptokencontentcache.h"
+#include "cpptokenhashcache.h"
+#include "cppwordfilterplan.h"
 
 #include <coreplugin/actionmanager/actioncontainer.h>
 #include <coreplugin/actionmanager/actionmanager.h>
@@ -64,55 +69,13 @@ namespace Internal {
 const char MIME_TYPE_CXX_DOX[] = "text/x-c++dox";
 /*! Task index name for the C++ document parser progress notification. */
 const char TASK_INDEX[] = "SpellChecker.Task.CppParse";
+/*! Maximum estimated size in bytes of the words of tokens that are shared
+ * between files. */
+constexpr std::size_t TOKEN_CONTENT_CACHE_SIZE = 16 * 1024 * 1024;
 
 // --------------------------------------------------
 // --------------------------------------------------
 // --------------------------------------------------
-/*! \brief Wrapper for HashWords to ensure proper locking.
- *
- * Even after a lot of diligence and effort there were still threading
- * issues with some container. For this reason it was decided to add
- * wrappers around some aspects to try and force proper usage.
- *
- * This should allow for better maintainability by removing the burden of
- * locking from the user completely and placing it on the maintainer of this
- * class. */
-class LockedTokenHash
-{
-  LockedTokenHash( const LockedTokenHash& other )      = delete;
-  LockedTokenHash& operator=( const LockedTokenHash& ) = delete;
-public:
-  /*! \brief Constructor. */
-  LockedTokenHash() = default;
-  /*! \brief Get a copy of the HashWords. */
-  HashWords get() const
-  {
-    QMutexLocker locker( &d_mutex );
-    HashWords words = d_tokenHashes;
-    return words;
-  }
-  /*! \brief Clear the hash words.
-   *
-   * This function can probably be removed since one can clear
-   * the hash using the assignment operator with an empty hash, but
-   * for clearness sake the function is kept. */
-  void clear()
-  {
-    QMutexLocker locker( &d_mutex );
-    d_tokenHashes.clear();
-  }
-  /*! \brief Assign a HashWords to the internal hashes. */
-  void operator=( const HashWords& other )
-  {
-    QMutexLocker locker( &d_mutex );
-    d_tokenHashes = other;
-  }
-
-private:
-  HashWords d_tokenHashes; /*!< The HashWords that are protected. */
-  mutable QMutex d_mutex;  /*!< The lock that guards the hashes. */
-};
-
 /*! \brief The ProgressNotification Wrapper.
  *
  * Even after a lot of diligence and effort there were still threading
@@ -148,20 +111,19 @@ public:
    * If there are enough files outstanding and the indicator does not exist it
    * will be created. If there are not enough outstanding and in progress,
    * the indicator will be removed. If the indicator exists, it will be updated.
-   * The "enough" is a hard coded, thumb-sucked value...
+   * The "enough" is more than what can be in process at the same time.
    *
    * \param filesInProject Total files that must be processed.
    * \param outstanding Number of files that must still be processed.
-   * \param inProcess Number of files that are currently in process. */
-  void update( int32_t filesInProject, int32_t outstanding, int32_t inProcess )
+   * \param inProcess Number of files that are currently in process.
+   * \param windowSize Number of files that can be in process at the same time.
+   * \param progressText Text that is shown with the progress. */
+  void update( int32_t filesInProject, int32_t outstanding, int32_t inProcess, int32_t windowSize, const QString& progressText )
   {
-    /* Thumb-suck value to decide when the future should be created and
-     * when it should be destroyed. */
-    constexpr int32_t cFILE_OUT_COUNT = 10;
     QMutexLocker locker( &d_mutex );
-    /* If there are more than 10 files in the waiting queue, create a progress
-     * notification. */
-    if( ( outstanding > cFILE_OUT_COUNT )
+    /* If there are more files in the waiting queue than what can be in
+     * process at the same time, create a progress notification. */
+    if( ( outstanding > windowSize )
         && ( d_progressObject == nullptr ) ) {
       d_progressObject = std::make_unique<QFutureInterface<void>>();
       d_progressObject->setProgressRange( 0, filesInProject );
@@ -172,15 +134,15 @@ public:
       /* Update the progress here and return immediately.
        * This is done to prevent the check below that should be unnecessary
        * since the object will be valid and should not be deleted. */
-      d_progressObject->setProgressValue( filesInProject - outstanding - inProcess );
+      d_progressObject->setProgressValueAndText( filesInProject - outstanding - inProcess, progressText );
       return;
     }
 
     /* If there is a progress notification, update it */
     if( d_progressObject != nullptr ) {
       d_progressObject->setProgressRange( 0, filesInProject );
-      d_progressObject->setProgressValue( filesInProject - outstanding - inProcess );
-      if( ( outstanding + inProcess ) < cFILE_OUT_COUNT ) {
+      d_progressObject->setProgressValueAndText( filesInProject - outstanding - inProcess, progressText );
+      if( ( outstanding + inProcess ) < windowSize ) {
         /* All done, remove the progress notification. */
         d_progressObject->reportFinished();
         d_progressObject.reset();
@@ -288,6 +250,19 @@ public:
   QString currentEditorFileName;
   CppParserSettings settings;
   CppParserOptionsPage optionsPage{&settings};
+  CppWordFilterPlanPtr filterPlan;     /*!< Plan that applies the settings to
+                                        * the words, shared with all of the
+                                        * document processors. It is created
+                                        * again each time the settings change. */
+  CppIdentifierIndexPtr identifierIndex; /*!< Identifiers that appear in the
+                                          * source of the project, shared with
+                                          * all of the document processors. */
+  CppTokenContentCachePtr tokenContents; /*!< Words of tokens by their content,
+                                          * shared by the processors of all
+                                          * files. It is kept when the settings
+                                          * or the project change since the
+                                          * same tokens appear in many files and
+                                          * projects. */
   QStringSet filesInStartupProject;
   // --
   QMutex fileQeueMutex;                /*!< Mutex protecting the filesToUpdate and filesInProcess
@@ -308,14 +283,16 @@ public:
                                         * instructed to parse the file or there is
                                         * already a future parsing the file.
                                         * See above for why a std::set was used. */
-  LockedTokenHash tokenHashes;         /*!< Tokens and their hashes that are
-                                        * used to speed up processing the
-                                        * current file. The hashes of tokens
-                                        * (comments, literals, etc.) and their
-                                        * words are kept so that if the same token
-                                        * is encountered, the words can be reused
-                                        * without needing to process the token
-                                        * again. */
+  CppTokenHashCache tokenHashes;       /*!< Tokens and their hashes of the
+                                        * files that were parsed recently. The
+                                        * hashes of tokens (comments, literals,
+                                        * etc.) and their words are kept so that
+                                        * if the same token is encountered, the
+                                        * words can be reused without needing
+                                        * to process the token again. */
+  CppInFlightController inFlight;      /*!< Controls the number of files that
+                                        * are in process at the same time,
+                                        * see filesInProcess. */
   FutureWatchers futureWatchers;       /*!< List of future watchers created. This
                                         * list is used to cancel the futures as needed
                                         * for example when the application closes down,
@@ -328,10 +305,37 @@ public:
   CppDocumentParserPrivate()
     : activeProject( nullptr )
     , currentEditorFileName()
+    , identifierIndex( std::make_shared<CppIdentifierIndex>() )
+    , tokenContents( std::make_shared<CppTokenContentCache>( TOKEN_CONTENT_CACHE_SIZE ) )
     , filesInStartupProject()
+    , tokenHashes( tokenCacheMaximumSize() )
+    , inFlight( SpellCheckerCore::instance()->settings()->minimumFilesInProcess, SpellCheckerCore::instance()->settings()->maximumFilesInProcess )
     , progressObject()
   {}
 
+  /*! \brief Text for the progress notification, with the statistics of
+   * the files in process and of the token hash cache. */
+  QString progressText() const
+  {
+    const CppInFlightController::Statistics inFlightStats = inFlight.statistics();
+    const CppTokenHashCache::Statistics cacheStats        = tokenHashes.statistics();
+    return CppDocumentParser::tr( "%1 of %2 files in process, %3 ms per file, %4% cache hits" )
+        .arg( inFlightStats.inFlight )
+        .arg( inFlightStats.windowSize )
+        .arg( inFlightStats.latencyMs, 0, 'f', 1 )
+        .arg( cacheStats.hitRate() * 100.0, 0, 'f', 0 );
+  }
+  // ------------------------------------------
+
+  /*! \brief Maximum size of the token hash cache in bytes, from the
+   * settings of the core. */
+  static std::size_t tokenCacheMaximumSize()
+  {
+    const int32_t sizeMiB = SpellCheckerCore::instance()->settings()->tokenCacheSize;
+    return std::size_t( std::max( sizeMiB, 0 ) ) * 1024 * 1024;
+  }
+  // ------------------------------------------
+
   /*! \brief Get all C++ files from the \a list of files.
    *
    * This function uses the MIME Types of the passed files and check if
@@ -363,6 +367,26 @@ public:
   }
   // ------------------------------------------
 
+  /*! \brief Check if the \a document of the code model is up to date.
+   *
+   * A document is stale if it is older than the editor of the file, by the
+   * revision of the editor, or older than the file on disk if the file is not
+   * open in an editor. An up to date document can still have its source
+   * released, the code model does this once it indexed a file. */
+  static bool isDocumentUpToDate( const CPlusPlus::Document::Ptr& document )
+  {
+    if( document.isNull() == true ) {
+      return false;
+    }
+    static CppEditor::CppModelManager* modelManager       = CppEditor::CppModelManager::instance();
+    CppEditor::CppEditorDocumentHandle* cppEditorDocument = modelManager->cppEditorDocument( document->filePath() );
+    if( cppEditorDocument != nullptr ) {
+      return cppEditorDocument->revision() == document->editorRevision();
+    }
+    return document->lastModified() == document->filePath().lastModified();
+  }
+  // ------------------------------------------
+
   /*! \brief Utility function to erase a file from the set if the file
    * is in the set.
    *
@@ -388,6 +412,7 @@ CppDocumentParser::CppDocumentParser( QObject* parent )
 {
   /* Create the settings for this parser */
   d->settings.loadFromSettings( Core::ICore::settings() );
+  d->filterPlan = std::make_shared<const CppWordFilterPlan>( d->settings );
   connect(                &d->settings,               &CppParserSettings::settingsChanged,                                this, &CppDocumentParser::settingsChanged );
   connect( SpellCheckerCore::instance()->settings(), &SpellChecker::Internal::SpellCheckerCoreSettings::settingsChanged, this, &CppDocumentParser::settingsChanged );
 
@@ -434,6 +459,8 @@ void CppDocumentParser::setActiveProject( ProjectExplorer::Project* activeProjec
 {
   d->activeProject = activeProject;
   d->filesInStartupProject.clear();
+  d->identifierIndex->clear();
+  d->tokenHashes.clear();
 
   /* Call reparseProject() to reset and clean up properly.
    * The logic inside will ensure that parsing is not started again
@@ -444,7 +471,8 @@ void CppDocumentParser::setActiveProject( ProjectExplorer::Project* activeProjec
 
 void CppDocumentParser::updateProjectFiles( QStringSet filesAdded, QStringSet filesRemoved )
 {
-  Q_UNUSED( filesRemoved )
+  d->identifierIndex->removeFiles( filesRemoved );
+  d->tokenHashes.remove( filesRemoved );
   const QStringSet fileSet = d->getCppFiles( filesAdded );
   d->filesInStartupProject.unite( fileSet );
   {
@@ -488,12 +516,16 @@ void CppDocumentParser::parseCppDocumentOnUpdate( CPlusPlus::Document::Ptr docPt
      * processed at the same time. */
     if( shouldParse == false ) {
       d->eraseIfFound( d->filesInProcess, fileName );
+      d->inFlight.dropped( fileName );
     } else {
       d->filesInProcess.insert( fileName );
     }
   }
 
   if( shouldParse == true ) {
+    /* The document is still being updated by the code model on this thread,
+     * keep its source before it gets released. */
+    docPtr->keepSourceAndAST();
     parseCppDocument( std::move( docPtr ) );
   }
 
@@ -505,8 +537,13 @@ void CppDocumentParser::parseCppDocumentOnUpdate( CPlusPlus::Document::Ptr docPt
 
 void CppDocumentParser::settingsChanged()
 {
+  /* Processors that are still running keep using the previous plan. */
+  d->filterPlan = std::make_shared<const CppWordFilterPlan>( d->settings );
   /* Clear the hashes since all comments must be re parsed. */
   d->tokenHashes.clear();
+  d->tokenHashes.setMaximumSize( d->tokenCacheMaximumSize() );
+  const SpellChecker::Internal::SpellCheckerCoreSettings* coreSettings = SpellCheckerCore::instance()->settings();
+  d->inFlight.setLimits( coreSettings->minimumFilesInProcess, coreSettings->maximumFilesInProcess );
   /* Re parse the project */
   reparseProject();
 }
@@ -536,6 +573,7 @@ void CppDocumentParser::reparseProject()
     /* Add the files to the waiting queue and then process the queue */
     QMutexLocker locker( &d->fileQeueMutex );
     d->filesInProcess.clear();
+    d->inFlight.clear();
     d->filesToUpdate.clear();
     d->filesToUpdate = Utils::transform<std::set<QString>>( fileSet, []( const QString& string ) { return string; } );
   }
@@ -550,19 +588,64 @@ void CppDocumentParser::queueFilesForUpdate()
   static CppEditor::CppModelManager* modelManager = CppEditor::CppModelManager::instance();
 
   QSet<Utils::FilePath> filesToUpdate;
+  QStringList filesToLex;
+  QList<CPlusPlus::Document::Ptr> documentsToHarvest;
+  QList<CPlusPlus::Document::Ptr> documentsToLex;
   size_t filesOutstanding;
   size_t filesInProcess;
+  /* The number of files in process at the same time is adapted to how fast
+   * the files are processed. */
+  const int32_t windowSize = d->inFlight.windowSize();
 
   {
     QMutexLocker locker( &d->fileQeueMutex );
+    /* The code model parses the files of the project by itself. Documents
+     * that it already parsed are taken from its snapshot and only the files
+     * that are missing or stale are parsed again. */
+    CPlusPlus::Snapshot snapshot;
+    if( ( d->settings.useCodeModelSnapshot == true )
+        && ( d->filesToUpdate.empty() == false ) ) {
+      snapshot = modelManager->snapshot();
+    }
     auto fileIter = d->filesToUpdate.begin();
-    while( ( d->filesInProcess.size() < 10 )
+    while( ( d->filesInProcess.size() < size_t( windowSize ) )
            && ( d->filesToUpdate.empty() == false ) ) {
       const QString file = ( *fileIter );
       fileIter = d->filesToUpdate.erase( fileIter );
       if( shouldParseDocument( file ) == true ) {
         d->filesInProcess.insert( file );
-        filesToUpdate.insert( Utils::FilePath::fromString(file) );
+        const Utils::FilePath filePath    = Utils::FilePath::fromString( file );
+        CPlusPlus::Document::Ptr document = snapshot.document( filePath );
+        const bool upToDate               = d->isDocumentUpToDate( document );
+        /* Documents that the code model already parsed are used as is. The
+         * source is kept before it is checked, the code model can release
+         * it at any time on its own threads. The code model releases the
+         * source of nearly all documents once it indexed them, such a
+         * document can not be used as is. */
+        bool sourceKept = false;
+        if( upToDate == true ) {
+          document->keepSourceAndAST();
+          sourceKept = ( document->utf8Source().isEmpty() == false );
+          if( sourceKept == false ) {
+            document->releaseSourceAndAST();
+          }
+        }
+        /* Files that are not open in an editor can be lexed from disk
+         * without waiting for the code model to parse them. If the document
+         * of the code model is up to date, its identifiers are used. */
+        if( sourceKept == true ) {
+          documentsToHarvest.append( std::move( document ) );
+        } else if( ( d->settings.lexClosedFiles == true )
+                   && ( file != d->currentEditorFileName )
+                   && ( modelManager->cppEditorDocument( filePath ) == nullptr ) ) {
+          if( upToDate == true ) {
+            documentsToLex.append( std::move( document ) );
+          } else {
+            filesToLex.append( file );
+          }
+        } else {
+          filesToUpdate.insert( filePath );
+        }
       }
     }
 
@@ -570,9 +653,21 @@ void CppDocumentParser::queueFilesForUpdate()
     filesInProcess   = d->filesInProcess.size();
   }
 
-  d->progressObject.update( d->filesInStartupProject.count(), int32_t( filesOutstanding ), int32_t( filesInProcess ) );
+  d->progressObject.update( d->filesInStartupProject.count(), int32_t( filesOutstanding ), int32_t( filesInProcess ), windowSize, d->progressText() );
 
-  modelManager->updateSourceFiles( filesToUpdate );
+  for( CPlusPlus::Document::Ptr& document: documentsToHarvest ) {
+    parseCppDocument( std::move( document ) );
+  }
+  for( CPlusPlus::Document::Ptr& document: documentsToLex ) {
+    const QString fileName = document->filePath().toString();
+    parseCppSource( fileName, std::move( document ) );
+  }
+  for( const QString& file: std::as_const( filesToLex ) ) {
+    parseCppSource( file, {} );
+  }
+  if( filesToUpdate.isEmpty() == false ) {
+    modelManager->updateSourceFiles( filesToUpdate );
+  }
 }
 // --------------------------------------------------
 
@@ -609,20 +704,18 @@ void CppDocumentParser::futureFinished()
      * the list of watchers, thus no need to do anything more. */
     return;
   }
-  const CppDocumentProcessor::ResultType result = watcher->result();
+  /* The result is moved out of the future, it is not used by anything else. */
+  CppDocumentProcessor::ResultType result = watcher->future().takeResult();
 
   const QString fileName = d->futureWatchers.remove( watcher );
-  if( fileName == d->currentEditorFileName ) {
-    /* Move the new list of hashes to the member data so that
-     * it can be used the next time around. Move is made explicit since
-     * the LHS can be removed and the RHS will not be used again from
-     * here on. */
-    d->tokenHashes = std::move( result.wordHashes );
-  }
+  /* Move the new list of hashes to the cache so that it can be used the
+   * next time that the file is parsed. */
+  d->tokenHashes.insert( fileName, std::move( result.wordHashes ) );
 
   {
     QMutexLocker locker( &d->fileQeueMutex );
     d->eraseIfFound( d->filesInProcess, fileName );
+    d->inFlight.finished( fileName, qsizetype( d->filesToUpdate.size() ) );
   }
   queueFilesForUpdate();
 
@@ -639,24 +732,52 @@ void CppDocumentParser::aboutToQuit()
 // --------------------------------------------------
 
 void CppDocumentParser::parseCppDocument( CPlusPlus::Document::Ptr docPtr )
+{
+  const QString fileName = docPtr->filePath().toString();
+  /* The hashes of the previous pass over the file, if the file is still
+   * in the cache. */
+  HashWordsPtr hashes = d->tokenHashes.find( fileName );
+  /* Create a document parser for the document. */
+  CppDocumentProcessor* parser = new CppDocumentProcessor( docPtr, hashes, d->filterPlan, d->identifierIndex, d->tokenContents );
+  /* Reset the document pointer so that it can be released as soon as it is
+   * done in the processor. The processor makes its own copy to keep it
+   * alive. */
+  docPtr.reset();
+  startProcessor( parser, fileName );
+}
+// --------------------------------------------------
+
+void CppDocumentParser::parseCppSource( const QString& fileName, CPlusPlus::Document::Ptr identifierDocument )
+{
+  /* The hashes of the previous pass over the file are used the same as for a
+   * document. */
+  HashWordsPtr hashes = d->tokenHashes.find( fileName );
+  CppDocumentProcessor* parser = new CppDocumentProcessor( fileName, std::move( identifierDocument ), hashes, d->filterPlan, d->identifierIndex, d->tokenContents );
+  startProcessor( parser, fileName );
+}
+// --------------------------------------------------
+
+CppInFlightController::Statistics CppDocumentParser::inFlightStatistics() const
+{
+  return d->inFlight.statistics();
+}
+// --------------------------------------------------
+
+CppTokenHashCache::Statistics CppDocumentParser::tokenCacheStatistics() const
+{
+  return d->tokenHashes.statistics();
+}
+// --------------------------------------------------
+
+void CppDocumentParser::startProcessor( CppDocumentProcessor* parser, const QString& fileName )
 {
   using Watcher    = CppDocumentProcessor::Watcher;
   using WatcherPtr = CppDocumentProcessor::WatcherPtr;
   using ResultType = CppDocumentProcessor::ResultType;
-  const QString fileName = docPtr->filePath().toString();
-  HashWords hashes;
-  if( fileName == d->currentEditorFileName ) {
-    hashes = d->tokenHashes.get();
-  }
-  /* Create a document parser and move it to the main thread.
+  /* Move the parser to the main thread.
    * Not sure if this is required but it seemed like a good
    * idea since this will be in a QThreadPool thread. */
-  CppDocumentProcessor* parser = new CppDocumentProcessor( docPtr, hashes, d->settings );
   parser->moveToThread( qApp->thread() );
-  /* Reset the document pointer so that it can be released as soon as it is
-   * done in the processor. The processor makes its own copy to keep it
-   * alive. */
-  docPtr.reset();
 
   /* Create a Future watcher that will be used to watch the future
    * promised by the processor.
@@ -669,6 +790,9 @@ void CppDocumentParser::parseCppDocument( CPlusPlus::Document::Ptr docPtr )
   connect( watcher, &Watcher::finished, parser, &CppDocumentProcessor::deleteLater );
   /* Keep track of the watchers so that they can be cancelled as needed. */
   d->futureWatchers.add( watcher, fileName );
+  /* The time of the processor is measured for the window of files in
+   * process, also for files that were not queued by this parser. */
+  d->inFlight.started( fileName );
   /* Create a future to process the file.
    * If the file to process is the current open editor, it is parsed in a new
    * thread with high priority.
@@ -687,262 +811,6 @@ void CppDocumentParser::parseCppDocument( CPlusPlus::Document::Ptr docPtr )
 }
 // --------------------------------------------------
 
-void CppDocumentParser::applySettingsToWords( const CppParserSettings& settings, const QString& string, const QStringSet& wordsInSource, WordList& words )
-{
-  using namespace SpellChecker::Parsers::CppParser;
-
-  /* Filter out words that appears in the source. They are checked against the list
-   * of words parsed from the file before the for loop. */
-  if( settings.removeWordsThatAppearInSource == true ) {
-    removeWordsThatAppearInSource( wordsInSource, words );
-  }
-
-  /* Regular Expressions that might be used, defined here so that it does not get cleared in the
-   * loop. They are made static const because they will be re-used a lot and will never be changed.
-   * This way the construction of the objects can be done once and then be re-used. */
-  static const QRegularExpression doubleRe( QStringLiteral( "\\A\\d+(\\.\\d+)?\\z" ), QRegularExpression::DontCaptureOption );
-  static const QRegularExpression hexRe( QStringLiteral( "\\A0x[0-9A-Fa-f]+\\z" ) );
-  static const QRegularExpression colorRe( QStringLiteral( "\\A([0-9A-Fa-f]{2}){3,4}\\z" ), QRegularExpression::DontCaptureOption );
-  static const QRegularExpression emailRe( QStringLiteral( "\\A" ) + QLatin1String( SpellChecker::Parsers::CppParser::Constants::EMAIL_ADDRESS_REGEXP_PATTERN ) + QStringLiteral( "\\z" ) );
-  static const QRegularExpression websiteRe( QString() + QLatin1String( SpellChecker::Parsers::CppParser::Constants::WEBSITE_ADDRESS_REGEXP_PATTERN ) );
-  static const QRegularExpression websiteCharsRe( QString() + QLatin1String( SpellChecker::Parsers::CppParser::Constants::WEBSITE_CHARS_REGEXP_PATTERN ) );
-
-  /* Word list that can be added to in the case that a word is split up into different words
-   * due to some setting or rule. These words can also be checked against the settings using
-   * recursion or not. It depends on the implementation that did the splitting of the
-   * original word. It is done in this way so that the iterator that is currently operating
-   * on the list of words does not break when new words get added during iteration */
-  WordList wordsToAddInTheEnd;
-  /* Iterate through the list of words using an iterator and remove words according to settings */
-  WordList::Iterator iter = words.begin();
-  while( iter != words.end() ) {
-    const Word& word        = ( *iter );
-    QString currentWord     = word.text;
-    QString currentWordCaps = currentWord.toUpper();
-    bool removeCurrentWord  = false;
-
-    /* Remove reserved words first. Although this does not depend on settings, this
-     * is done here to prevent multiple iterations through the word list where possible */
-    removeCurrentWord = isReservedWord( currentWord );
-
-    if( removeCurrentWord == false ) {
-      /* Remove the word if it is a number, checking for floats and doubles as well.
-       * Or if it is a hex number
-       * Or if it can be a color and it starts with a #, then it is a color.*/
-      removeCurrentWord = ( doubleRe.match( currentWord ).hasMatch() == true )
-                          || ( hexRe.match( currentWord ).hasMatch() == true )
-                          || ( ( colorRe.match( currentWord ).hasMatch() == true )
-                               && ( string.at( word.start - 1 ) == QLatin1Char( '#' ) ) );
-
-    }
-
-    if( ( removeCurrentWord == false ) && ( settings.checkQtKeywords == false ) ) {
-      /* Remove the basic Qt Keywords using the isQtKeyword() function in the CppTools */
-      if( ( CppEditor::isQtKeyword( currentWord ) == true )
-          || ( CppEditor::isQtKeyword( currentWordCaps ) == true ) ) {
-        removeCurrentWord = true;
-      }
-      /* Remove words that Start with capital Q and the next char is also capital letter. This would
-       * only apply to words longer than 2 characters long. This check is also to ensure that we do
-       * not go past the size of the word */
-      if( currentWord.length() > 2 ) {
-        if( ( currentWord.at( 0 ) == QLatin1Char( 'Q' ) ) && ( currentWord.at( 1 ).isUpper() == true ) ) {
-          removeCurrentWord = true;
-        }
-      }
-
-      /* Remove all caps words that start with Q_ */
-      if( currentWord.startsWith( QLatin1String( "Q_" ), Qt::CaseSensitive ) == true ) {
-        removeCurrentWord = true;
-      }
-
-      /* Remove qDebug() */
-      if( currentWord == QLatin1String( "qDebug" ) ) {
-        removeCurrentWord = true;
-      }
-    }
-
-    if( ( settings.removeEmailAddresses == true ) && ( removeCurrentWord == false ) ) {
-      if( emailRe.match( currentWord ).hasMatch() == true ) {
-        removeCurrentWord = true;
-      }
-    }
-
-    /* Attempt to remove website addresses using the websiteRe Regular Expression. */
-    if( ( settings.removeWebsites == true ) && ( removeCurrentWord == false ) ) {
-      if( websiteRe.match( currentWord ).hasMatch() == true ) {
-        removeCurrentWord = true;
-      } else if( currentWord.contains( websiteCharsRe ) == true ) {
-        QStringList wordsSplitOnWebChars = currentWord.split( websiteCharsRe, Qt::SkipEmptyParts );
-        if( wordsSplitOnWebChars.isEmpty() == false ) {
-          /* String is not a website, check each component now */
-          removeCurrentWord = true;
-          WordList wordsFromSplit;
-          IDocumentParser::getWordsFromSplitString( wordsSplitOnWebChars, word, wordsFromSplit );
-          /* Apply the settings to the words that came from the split to filter out words that does
-           * not belong due to settings. After they have passed the settings, add the words that
-           * survived to the list of words that should be added in the end */
-          applySettingsToWords( settings, string, wordsInSource, wordsFromSplit );
-          wordsToAddInTheEnd.append( wordsFromSplit );
-        }
-      }
-    }
-
-    if( ( settings.checkAllCapsWords == false ) && ( removeCurrentWord == false ) ) {
-      /* Remove words that are all caps */
-      if( currentWord == currentWordCaps ) {
-        removeCurrentWord = true;
-      }
-    }
-
-    if( ( settings.wordsWithNumberOption != CppParserSettings::LeaveWordsWithNumbers ) && ( removeCurrentWord == false ) ) {
-      /* Before doing anything, check if the word contains any numbers. If it does then we can go to
-       * the settings to handle the word differently */
-      static const QRegularExpression numberContainRe( QStringLiteral( "[0-9]" ) );
-      static const QRegularExpression numberSplitRe( QStringLiteral( "[0-9]+" ) );
-      if( currentWord.contains( numberContainRe ) == true ) {
-        /* Handle words with numbers based on the setting that is set for them */
-        if( settings.wordsWithNumberOption == CppParserSettings::RemoveWordsWithNumbers ) {
-          removeCurrentWord = true;
-        } else if( settings.wordsWithNumberOption == CppParserSettings::SplitWordsOnNumbers ) {
-          removeCurrentWord = true;
-          QStringList wordsSplitOnNumbers = currentWord.split( numberSplitRe, Qt::SkipEmptyParts );
-          WordList wordsFromSplit;
-          IDocumentParser::getWordsFromSplitString( wordsSplitOnNumbers, word, wordsFromSplit );
-          /* Apply the settings to the words that came from the split to filter out words that does
-           * not belong due to settings. After they have passed the settings, add the words that
-           * survived to the list of words that should be added in the end */
-          applySettingsToWords( settings, string, wordsInSource, wordsFromSplit );
-          wordsToAddInTheEnd.append( wordsFromSplit );
-        } else {
-          /* Should never get here */
-          QTC_CHECK( false );
-        }
-      }
-    }
-
-    if( ( settings.wordsWithUnderscoresOption != CppParserSettings::LeaveWordsWithUnderscores ) && ( removeCurrentWord == false ) ) {
-      /* Check to see if the word has underscores in it. If it does then handle according to the
-       * settings */
-      if( currentWord.contains( QLatin1Char( '_' ) ) == true ) {
-        if( settings.wordsWithUnderscoresOption == CppParserSettings::RemoveWordsWithUnderscores ) {
-          removeCurrentWord = true;
-        } else if( settings.wordsWithUnderscoresOption == CppParserSettings::SplitWordsOnUnderscores ) {
-          removeCurrentWord = true;
-          static const QRegularExpression underscoreSplitRe( QStringLiteral( "_+" ) );
-          QStringList wordsSplitOnUnderScores = currentWord.split( underscoreSplitRe, Qt::SkipEmptyParts );
-          WordList wordsFromSplit;
-          IDocumentParser::getWordsFromSplitString( wordsSplitOnUnderScores, word, wordsFromSplit );
-          /* Apply the settings to the words that came from the split to filter out words that does
-           * not belong due to settings. After they have passed the settings, add the words that
-           * survived to the list of words that should be added in the end */
-          applySettingsToWords( settings, string, wordsInSource, wordsFromSplit );
-          wordsToAddInTheEnd.append( wordsFromSplit );
-        } else {
-          /* Should never get here */
-          QTC_CHECK( false );
-        }
-      }
-    }
-
-    /* Settings for CamelCase */
-    if( ( settings.camelCaseWordOption != CppParserSettings::LeaveWordsInCamelCase ) && ( removeCurrentWord == false ) ) {
-      /* Check to see if the word appears to be in camelCase. If it does, handle according to the
-       * settings */
-      /* The check is not precise and accurate science, but a rough estimation of the word is in
-       * camelCase. This will probably be updated as this gets tested. The current check checks for
-       * one or more lower case letters,
-       * followed by one or more upper-case letter, followed by a lower case letter */
-      static const QRegularExpression camelCaseContainsRe( QStringLiteral( "[a-z]{1,}[A-Z]{1,}[a-z]{1,}" ) );
-      static const QRegularExpression camelCaseIndexRe( QStringLiteral( "[a-z][A-Z]" ) );
-      if( currentWord.contains( camelCaseContainsRe ) == true ) {
-        if( settings.camelCaseWordOption == CppParserSettings::RemoveWordsInCamelCase ) {
-          removeCurrentWord = true;
-        } else if( settings.camelCaseWordOption == CppParserSettings::SplitWordsOnCamelCase ) {
-          removeCurrentWord = true;
-          QStringList wordsSplitOnCamelCase;
-          /* Search the word for all indexes where there is a lower case letter followed by an upper
-           * case letter. This indexes are then later used to split the current word into a list of
-           * new words. 0 is added as the starting index, since the first word will start at 0. At
-           * the end the length
-           * of the word is also added, since the last word will stop at the end */
-          QList<int> indexes;
-          indexes << 0;
-          int currentIdx = 0;
-          int lastIdx    = 0;
-          bool finished  = false;
-          while( finished == false ) {
-            currentIdx = currentWord.indexOf( camelCaseIndexRe, lastIdx );
-            if( currentIdx == -1 ) {
-              finished = true;
-              indexes << currentWord.length();
-            } else {
-              lastIdx = currentIdx + 1;
-              indexes << lastIdx;
-            }
-          }
-          /* Now split the word on the indexes */
-          for( int idx = 0; idx < indexes.count() - 1; ++idx ) {
-            /* Get the word starting at the current index, up to the difference between the
-             * different index and the current index, since the second argument of QString::mid() is
-             * the length to extract and not the index of the last position */
-            QString word = currentWord.mid( indexes.at( idx ), indexes.at( idx + 1 ) - indexes.at( idx ) );
-            wordsSplitOnCamelCase << word;
-          }
-          WordList wordsFromSplit;
-          /* Get the proper word structures for the words extracted during the split */
-          IDocumentParser::getWordsFromSplitString( wordsSplitOnCamelCase, word, wordsFromSplit );
-          /* Apply the settings to the words that came from the split to filter out words that does
-           * not belong due to settings. After they have passed the settings, add the words that
-           * survived to the list of words that should be added in the end */
-          applySettingsToWords( settings, string, wordsInSource, wordsFromSplit );
-          wordsToAddInTheEnd.append( wordsFromSplit );
-        } else {
-          /* Should never get here */
-          QTC_CHECK( false );
-        }
-      }
-    }
-
-    /* Words.with.dots */
-    if( ( settings.wordsWithDotsOption != CppParserSettings::LeaveWordsWithDots ) && ( removeCurrentWord == false ) ) {
-      /* Check to see if the word has dots in it.
-       * If it does then handle according to the settings */
-      if( currentWord.contains( QLatin1Char( '.' ) ) == true ) {
-        if( settings.wordsWithDotsOption == CppParserSettings::RemoveWordsWithDots ) {
-          removeCurrentWord = true;
-        } else if( settings.wordsWithDotsOption == CppParserSettings::SplitWordsOnDots ) {
-          removeCurrentWord = true;
-          static const QRegularExpression dotsSplitRe( QStringLiteral( "\\.+" ) );
-          QStringList wordsSplitOnDots = currentWord.split( dotsSplitRe, Qt::SkipEmptyParts );
-          WordList wordsFromSplit;
-          IDocumentParser::getWordsFromSplitString( wordsSplitOnDots, word, wordsFromSplit );
-          /* Apply the settings to the words that came from the split to filter out words that does
-           * not belong due to settings. After they have passed the settings, add the words that
-           * survived to the list of words that should be added in the end */
-          applySettingsToWords( settings, string, wordsInSource, wordsFromSplit );
-          wordsToAddInTheEnd.append( wordsFromSplit );
-        } else {
-          /* Should never get here */
-          QTC_CHECK( false );
-        }
-      }
-    }
-
-    /* Remove the current word if it should be removed. The word will get removed in place. The
-     * erase() function on the list will return an iterator to the next element. In this case,
-     * the iterator should not be incremented and the while loop should continue to the next
-     * element. */
-    if( removeCurrentWord == true ) {
-      iter = words.erase( iter );
-    } else {
-      ++iter;
-    }
-  }
-  /* Add the words that should be added in the end to the list of words */
-  words.append( wordsToAddInTheEnd );
-}
-// --------------------------------------------------
 
 // --------------------------------------------------
 
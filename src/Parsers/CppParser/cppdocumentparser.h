@@ -21,6 +21,8 @@
 #pragma once
 
 #include "../../idocumentparser.h"
+#include "cppinflightcontroller.h"
+#include "cpptokenhashcache.h"
 
 #include <cplusplus/CppDocument.h>
 #include <projectexplorer/projectexplorer.h>
@@ -37,6 +39,7 @@ namespace Internal {
 
 class CppParserSettings;
 class CppDocumentParserPrivate;
+class CppDocumentProcessor;
 
 class CppDocumentParser
   : public SpellChecker::IDocumentParser
@@ -76,7 +79,7 @@ protected slots:
   void aboutToQuit();
 
 public:
-  void reparseProject();
+  void reparseProject() Q_DECL_OVERRIDE;
   /*! \brief Query if the given file should be parsed.
    *
    * This function takes the global/core settings, local C++ Parser settings
@@ -89,19 +92,38 @@ public:
    *
    * Work through the document and parse the file to extract words that should
    * be checked for spelling mistakes.
-   * \param[in] docPtr Pointer to the document that will get parsed.
+   * \param[in] docPtr Pointer to the document that will get parsed. The source
+   *              and AST of the document must already be kept, the processor
+   *              releases them once it is done.
    * \return A list of words extracted that should be checked for spelling mistakes. */
   void parseCppDocument( CPlusPlus::Document::Ptr docPtr );
-  /*! \brief Apply the user Settings to the Words.
-   * \param[in] string String that these words belong to.
-   * \param[in] wordsInSource List of words that appear in the source. Based on the user
-   *                  setting words that appear in this list will be removed from the
-   *                  final list of \a words.
-   * \param[inout] words words that should be parsed. Words will be removed from this list
-   *                  based on the user settings.  */
-  static void applySettingsToWords( const CppParserSettings& settings, const QString& string, const QStringSet& wordsInSource, WordList& words );
+  /*! \brief Parse a C++ file that is not open in an editor.
+   *
+   * The file is lexed from disk instead of waiting for the code model to
+   * parse it, see CppParserSettings::lexClosedFiles.
+   * \param[in] fileName Name of the file that will get parsed.
+   * \param[in] identifierDocument Up to date document of the code model for
+   *              the file, whose source was released. Its identifiers are
+   *              used instead of collecting them while lexing. Can be null. */
+  void parseCppSource( const QString& fileName, CPlusPlus::Document::Ptr identifierDocument );
+  /*! \brief Get the statistics of the files in process.
+   *
+   * This includes the current size of the window of files that are in
+   * process at the same time, it is also shown in the progress notification. */
+  CppInFlightController::Statistics inFlightStatistics() const;
+  /*! \brief Get the statistics of the cache of token hashes.
+   *
+   * This includes the hit rate of the cache, it is also shown in the
+   * progress notification. */
+  CppTokenHashCache::Statistics tokenCacheStatistics() const;
 
 private:
+  /*! \brief Start the \a parser in the background for the \a fileName.
+   *
+   * The parser is deleted once it is done, the words are handled in
+   * futureFinished(). */
+  void startProcessor( CppDocumentProcessor* parser, const QString& fileName );
+
   friend CppDocumentParserPrivate;
   CppDocumentParserPrivate* const d;
 };
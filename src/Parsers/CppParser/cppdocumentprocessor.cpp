@@ -18,14 +18,20 @@
 ** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
 ****************************************************************************/
 
-#include "cppdocumentparser.h"
 #include "cppdocumentprocessor.h"
-#include "cppparserconstants.h"
+#include "cpplineoffsettable.h"
+#include "cppsourcelexer.h"
+#include "cpptokenhash.h"
+#include "cppwordtokenizer.h"
 
-#include <cplusplus/Overview.h>
 #include <cppeditor/cppeditordocument.h>
 #include <cppeditor/cppdoxygen.h>
 #include <cppeditor/cppmodelmanager.h>
+#include <utils/qtcassert.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
 
 using namespace SpellChecker;
 using namespace SpellChecker::CppSpellChecker::Internal;
@@ -35,59 +41,193 @@ using namespace SpellChecker::CppSpellChecker::Internal;
 // #define SP_CHECK( test ) QTC_CHECK( test )
 #define SP_CHECK( test )
 
+/*! \brief Count the heap allocations made while a document is processed.
+ *
+ * If defined, the global operator new gets replaced with one that counts the
+ * allocations of the calling thread, and the number of allocations made
+ * while processing a document is printed for each document. This must only
+ * be used while benchmarking. */
+// #define BENCH_ALLOCATIONS
+
+#ifdef BENCH_ALLOCATIONS
+static thread_local uint64_t allocationCount = 0;
+
+void* operator new( std::size_t size )
+{
+  ++allocationCount;
+  void* pointer = std::malloc( ( size == 0 ) ? 1 : size );
+  if( pointer == nullptr ) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete( void* pointer ) noexcept
+{
+  std::free( pointer );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+  std::free( pointer );
+}
+#endif /* BENCH_ALLOCATIONS */
+
+/*! \brief Initial size of the memory arena of a processor.
+ *
+ * Large enough for the words of most files, the arena grows in larger
+ * blocks as needed. */
+constexpr std::size_t ARENA_INITIAL_SIZE = 64 * 1024;
+
 class SpellChecker::CppSpellChecker::Internal::CppDocumentProcessorPrivate
 {
 public:
   CPlusPlus::Document::Ptr docPtr;
-  HashWords tokenHashes;
-  CppParserSettings settings;
+  HashWordsPtr tokenHashes;
+  CppWordFilterPlanPtr plan;
+  CppIdentifierIndexPtr identifiers;
+  CppTokenContentCachePtr contentCache;
+  /*! \brief Lexer of the file, if the file is lexed from disk instead of
+   * using the document of the code model. */
+  std::unique_ptr<CppSourceLexer> lexer;
+  /*! \brief Document of the code model for the lexed file, if the code
+   * model already parsed it. Only its identifiers are used. */
+  CPlusPlus::Document::Ptr identifierDocument;
   CPlusPlus::TranslationUnit* trUnit;
   QString fileName;
-
-  CppDocumentProcessorPrivate( CPlusPlus::Document::Ptr documentPointer, const HashWords& hashWords, const CppParserSettings& cppSettings );
+  /*! \brief Memory for the words while the document is processed.
+   *
+   * All the words and strings that are only used while processing the
+   * document are allocated from the arena. The memory is only freed once
+   * the processor is done, all at once. */
+  std::pmr::monotonic_buffer_resource arena;
+  CppWordTokenizer tokenizer;
+
+  CppDocumentProcessorPrivate( CPlusPlus::Document::Ptr documentPointer, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache );
+  CppDocumentProcessorPrivate( const QString& sourceFileName, CPlusPlus::Document::Ptr identifierDocumentPointer, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache );
+  /*! \brief Copy the string to the arena, the returned view stays valid for
+   * as long as the processor. */
+  QStringView copyToArena( QStringView string );
 };
 // --------------------------------------------------
 // --------------------------------------------------
 // --------------------------------------------------
 
-CppDocumentProcessorPrivate::CppDocumentProcessorPrivate( CPlusPlus::Document::Ptr documentPointer, const HashWords& hashWords, const CppParserSettings& cppSettings )
+CppDocumentProcessorPrivate::CppDocumentProcessorPrivate( CPlusPlus::Document::Ptr documentPointer, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache )
   : docPtr( documentPointer )
   , tokenHashes( hashWords )
-  , settings( cppSettings )
+  , plan( filterPlan )
+  , identifiers( identifierIndex )
+  , contentCache( tokenContentCache )
   , trUnit( documentPointer->translationUnit() )
   , fileName( documentPointer->filePath().toString() )
+  , arena( ARENA_INITIAL_SIZE )
+  , tokenizer( filterPlan->removeWebsites() )
 {}
 // --------------------------------------------------
 
-CppDocumentProcessor::CppDocumentProcessor( CPlusPlus::Document::Ptr documentPointer, const HashWords& hashWords, const CppParserSettings& cppSettings )
-  : QObject( nullptr )
-  , d( new CppDocumentProcessorPrivate( documentPointer, hashWords, cppSettings ) )
+CppDocumentProcessorPrivate::CppDocumentProcessorPrivate( const QString& sourceFileName, CPlusPlus::Document::Ptr identifierDocumentPointer, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache )
+  : docPtr()
+  , tokenHashes( hashWords )
+  , plan( filterPlan )
+  , identifiers( identifierIndex )
+  , contentCache( tokenContentCache )
+  , lexer( std::make_unique<CppSourceLexer>( sourceFileName ) )
+  , identifierDocument( identifierDocumentPointer )
+  , trUnit( nullptr )
+  , fileName( sourceFileName )
+  , arena( ARENA_INITIAL_SIZE )
+  , tokenizer( filterPlan->removeWebsites() )
+{}
+// --------------------------------------------------
+
+QStringView CppDocumentProcessorPrivate::copyToArena( QStringView string )
 {
-  d->docPtr->keepSourceAndAST();
+  QChar* copy = static_cast<QChar*>( arena.allocate( std::size_t( string.size() ) * sizeof( QChar ), alignof( QChar ) ) );
+  std::copy( string.cbegin(), string.cend(), copy );
+  return QStringView( copy, string.size() );
 }
 // --------------------------------------------------
 
+CppDocumentProcessor::CppDocumentProcessor( CPlusPlus::Document::Ptr documentPointer, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache )
+  : QObject( nullptr )
+  , d( new CppDocumentProcessorPrivate( documentPointer, hashWords, filterPlan, identifierIndex, tokenContentCache ) )
+{}
+// --------------------------------------------------
+
+CppDocumentProcessor::CppDocumentProcessor( const QString& fileName, CPlusPlus::Document::Ptr identifierDocument, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache )
+  : QObject( nullptr )
+  , d( new CppDocumentProcessorPrivate( fileName, identifierDocument, hashWords, filterPlan, identifierIndex, tokenContentCache ) )
+{}
+// --------------------------------------------------
+
 CppDocumentProcessor::~CppDocumentProcessor()
 {
   if( d->docPtr != nullptr ) {
     d->docPtr->releaseSourceAndAST();
   }
+  /* The lexer keeps the file open, thus the private data must be released. */
+  delete d;
 }
 // --------------------------------------------------
 
 void CppDocumentProcessor::process( CppDocumentProcessor::Promise& promise )
 {
-  SP_CHECK( docPtr.isNull() == false );
-  SP_CHECK( trUnit != nullptr );
-  QStringSet wordsInSource;
-  QVector<WordTokens> wordTokens;
-  /* If the setting is set to remove words from the list based on words found in the source,
-   * parse the source file and then remove all words found in the source files from the list
-   * of words that will be checked. */
-  if( d->settings.removeWordsThatAppearInSource == true ) {
-    /* First get all words that does appear in the current source file. These words only
-     * include variables and their types */
-    wordsInSource = getWordsThatAppearInSource();
+#ifdef BENCH_ALLOCATIONS
+  const uint64_t allocationsAtStart = allocationCount;
+#endif /* BENCH_ALLOCATIONS */
+  /* Files that are not open in an editor can be lexed from disk, the rest
+   * are taken from the document of the code model. */
+  QVector<WordTokens> wordTokens = ( d->lexer != nullptr )
+                                   ? parseSource( promise )
+                                   : parseDocument( promise );
+
+  if( promise.isCanceled() == true ) {
+    promise.future().cancel();
+    return;
+  }
+
+  // ----------------------------------
+  /* Make a local copy of the last list of hashes. A local copy is made and used
+   * as the input the tokenize function, but a new list is returned from the
+   * tokenize function. If this is not done the list of hashes can grow forever
+   * and cause a huge increase in memory. Doing it this way ensure that the
+   * list only contains hashes of tokens that are present in during the last run
+   * and will not contain old and invalid hashes. It will cause the parsing of a
+   * different file than the previous run to be less efficient but if a file is
+   * parsed multiple times, one after the other, it will result in a large speed up
+   * and this will mostly be the case when editing a file. For this reason the initial
+   * project parse on start up can be slower. */
+
+  /* Populate the list of hashes from the tokens that was processed. */
+  HashWords newHashesOut;
+  WordList  newSettingsApplied;
+  for( WordTokens& token: wordTokens ) {
+    if( token.newHash == true ) {
+      /* The words are new, they were not known in a previous hash
+       * thus the settings must now be applied.
+       * Only words that have already been checked against the settings
+       * gets added to the hash, thus there is no need to apply the settings
+       * again, since this will only waste time. */
+      d->plan->apply( token.views );
+      /* Only the words that are kept are copied out of the token string. */
+      token.words.reserve( qsizetype( token.views.size() ) );
+      for( const WordView& view: token.views ) {
+        token.words.append( view.toWord( d->fileName ) );
+      }
+      /* Share the words with the other files that contain the same token.
+       * The shared words do not depend on the identifiers of this file. */
+      if( token.shareWords == true ) {
+        d->contentCache->insert( token.contentKey, CppTokenContentCache::toRelative( token.words, token.line, token.column ) );
+      }
+    }
+    /* The identifiers change while the project is parsed, thus they are
+     * removed from the words of every token each time, also from the words
+     * that were reused. The hash keeps the words from before this stage. */
+    d->plan->removeIdentifiers( *d->identifiers, token.words, newSettingsApplied );
+    SP_CHECK( token.hash != 0x00 );
+    /* The tokens are not used after this, the words are moved into the hash. */
+    newHashesOut[token.hash] = { token.line, token.column, token.length, std::move( token.words ) };
   }
 
   if( promise.isCanceled() == true ) {
@@ -95,7 +235,34 @@ void CppDocumentProcessor::process( CppDocumentProcessor::Promise& promise )
     return;
   }
 
-  if( d->settings.whatToCheck.testFlag( CppParserSettings::CheckStringLiterals ) == true ) {
+  /* Done, report the words that should be spellchecked. The list is shared
+   * from here on, thus it is finalized first. */
+  newSettingsApplied.finalize();
+  promise.addResult( ResultType{ std::move( newHashesOut ), std::make_shared<const WordList>( std::move( newSettingsApplied ) ) } );
+#ifdef BENCH_ALLOCATIONS
+  qDebug() << "File:" << d->fileName << "allocations:" << ( allocationCount - allocationsAtStart );
+#endif /* BENCH_ALLOCATIONS */
+}
+// --------------------------------------------------
+
+QVector<WordTokens> CppDocumentProcessor::parseDocument( Promise& promise ) const
+{
+  SP_CHECK( d->docPtr.isNull() == false );
+  SP_CHECK( d->trUnit != nullptr );
+  QVector<WordTokens> wordTokens;
+  /* If the setting is set to remove words from the list based on words found in the source,
+   * update the identifiers of this document in the project wide index. All words that are
+   * identifiers in any of the documents are then removed from the list of words that will
+   * be checked. */
+  if( d->plan->removeWordsThatAppearInSource() == true ) {
+    d->identifiers->update( d->docPtr );
+  }
+
+  if( promise.isCanceled() == true ) {
+    return {};
+  }
+
+  if( d->plan->whatToCheck().testFlag( CppParserSettings::CheckStringLiterals ) == true ) {
     /* Parse string literals */
     unsigned int tokenCount = d->trUnit->tokenCount();
     for( unsigned int idx = 0; idx < tokenCount; ++idx ) {
@@ -110,31 +277,29 @@ void CppDocumentProcessor::process( CppDocumentProcessor::Promise& promise )
         }
 
         /* The String Literal is not expanded thus handle it like a comment is handled. */
-        WordTokens tokens = parseToken( token, WordTokens::Type::Literal );
-        wordTokens.append( tokens );
+        wordTokens.append( parseToken( token, WordTokens::Type::Literal ) );
       }
     }
-    /* Parse macros */
-    wordTokens += parseMacros();
+    /* Parse macros. The tokens are moved so that their words stay in the arena. */
+    wordTokens.append( parseMacros() );
   }
 
   if( promise.isCanceled() == true ) {
-    promise.future().cancel();
-    return;
+    return {};
   }
 
-  if( d->settings.whatToCheck.testFlag( CppParserSettings::CheckComments ) == true ) {
+  if( d->plan->whatToCheck().testFlag( CppParserSettings::CheckComments ) == true ) {
     /* Parse comments */
     unsigned int commentCount = d->trUnit->commentCount();
     for( unsigned int comment = 0; comment < commentCount; ++comment ) {
       const CPlusPlus::Token& token = d->trUnit->commentAt( comment );
       /* Check to see if the current comment type must be checked */
-      if( ( d->settings.commentsToCheck.testFlag( CppParserSettings::CommentsC ) == false )
+      if( ( d->plan->commentsToCheck().testFlag( CppParserSettings::CommentsC ) == false )
           && ( token.kind() == CPlusPlus::T_COMMENT ) ) {
         /* C Style comments should not be checked and this is one */
         continue;
       }
-      if( ( d->settings.commentsToCheck.testFlag( CppParserSettings::CommentsCpp ) == false )
+      if( ( d->plan->commentsToCheck().testFlag( CppParserSettings::CommentsCpp ) == false )
           && ( token.kind() == CPlusPlus::T_CPP_COMMENT ) ) {
         /* C++ Style comments should not be checked and this is one */
         continue;
@@ -145,112 +310,79 @@ void CppDocumentProcessor::process( CppDocumentProcessor::Promise& promise )
           || ( token.kind() == CPlusPlus::T_CPP_DOXY_COMMENT ) ) {
         type = WordTokens::Type::Doxygen;
       }
-      const WordTokens tokens = parseToken( token, type );
-      wordTokens.append( tokens );
+      wordTokens.append( parseToken( token, type ) );
     }
   }
 
   if( promise.isCanceled() == true ) {
-    promise.future().cancel();
-    return;
+    return {};
   }
 
   /* At this point the DocPtr can be released since it will no longer be
    * Used */
   d->docPtr->releaseSourceAndAST();
   d->docPtr.reset();
-
-  // ----------------------------------
-  /* Make a local copy of the last list of hashes. A local copy is made and used
-   * as the input the tokenize function, but a new list is returned from the
-   * tokenize function. If this is not done the list of hashes can grow forever
-   * and cause a huge increase in memory. Doing it this way ensure that the
-   * list only contains hashes of tokens that are present in during the last run
-   * and will not contain old and invalid hashes. It will cause the parsing of a
-   * different file than the previous run to be less efficient but if a file is
-   * parsed multiple times, one after the other, it will result in a large speed up
-   * and this will mostly be the case when editing a file. For this reason the initial
-   * project parse on start up can be slower. */
-
-  /* Populate the list of hashes from the tokens that was processed. */
-  HashWords newHashesOut;
-  WordList  newSettingsApplied;
-  for( const WordTokens& token: qAsConst( wordTokens ) ) {
-    WordList words = token.words;
-    if( token.newHash == true ) {
-      /* The words are new, they were not known in a previous hash
-       * thus the settings must now be applied.
-       * Only words that have already been checked against the settings
-       * gets added to the hash, thus there is no need to apply the settings
-       * again, since this will only waste time. */
-      CppDocumentParser::applySettingsToWords( d->settings, token.string, wordsInSource, words );
-    }
-    newSettingsApplied.append( words );
-    SP_CHECK( token.hash != 0x00 );
-    newHashesOut[token.hash] = { token.line, token.column, words };
-  }
-
-  if( promise.isCanceled() == true ) {
-    promise.future().cancel();
-    return;
-  }
-
-  /* Done, report the words that should be spellchecked */
-  promise.addResult( ResultType{ std::move( newHashesOut ), std::move( newSettingsApplied ) } );
+  return wordTokens;
 }
 // --------------------------------------------------
 
-QStringSet CppDocumentProcessor::getWordsThatAppearInSource() const
+QVector<WordTokens> CppDocumentProcessor::parseSource( Promise& promise ) const
 {
-  QStringSet wordsSet;
-  SP_CHECK( docPtr != nullptr );
-  const uint32_t total = d->docPtr->globalSymbolCount();
-  CPlusPlus::Overview overview;
-  for( uint32_t i = 0; i < total; ++i ) {
-    CPlusPlus::Symbol* symbol = d->docPtr->globalSymbolAt( i );
-    wordsSet += getListOfWordsFromSourceRecursive( symbol, overview );
+  if( d->lexer->isValid() == false ) {
+    return {};
   }
-  return wordsSet;
-}
-// --------------------------------------------------
+  /* Lex the file. The identifiers are only collected if they are needed and
+   * the code model did not already parse the file. The control of a document
+   * keeps its identifiers, even after the source was released. */
+  const bool removeIdentifiers  = d->plan->removeWordsThatAppearInSource();
+  const bool collectIdentifiers = ( removeIdentifiers == true ) && ( d->identifierDocument == nullptr );
+  QVector<CppSourceLexer::Token> sourceTokens;
+  QStringList identifiers;
+  d->lexer->lex( sourceTokens, ( collectIdentifiers == true ) ? &identifiers : nullptr );
+  if( collectIdentifiers == true ) {
+    d->identifiers->update( d->fileName, std::move( identifiers ) );
+  } else if( removeIdentifiers == true ) {
+    d->identifiers->update( d->identifierDocument );
+  }
+  d->identifierDocument.reset();
 
-QStringSet CppDocumentProcessor::getListOfWordsFromSourceRecursive( const CPlusPlus::Symbol* symbol, const CPlusPlus::Overview& overview ) const
-{
-  QStringSet wordsInSource;
-  /* Get the pretty name and type for the current symbol. This name is then split up into
-   * different words that are added to the list of words that appear in the source */
-  const QString name = overview.prettyName( symbol->name() ).trimmed();
-  const QString type = overview.prettyType( symbol->type() ).trimmed();
-  wordsInSource += getPossibleNamesFromString( name );
-  wordsInSource += getPossibleNamesFromString( type );
-
-  /* Go to the next level into the scope of the symbol and get the words from that level as well*/
-  const CPlusPlus::Scope* scope = symbol->asScope();
-  if( scope != nullptr ) {
-    CPlusPlus::Scope::iterator cur = scope->memberBegin();
-    while( cur != scope->memberEnd() ) {
-      const CPlusPlus::Symbol* curSymbol = *cur;
-      ++cur;
-      if( !curSymbol ) {
+  if( promise.isCanceled() == true ) {
+    return {};
+  }
+
+  /* The tokens are in the order of the source, the same settings as for a
+   * document are applied to them. Literals that are arguments of macros are
+   * found by the lexer as normal literals. */
+  const bool checkLiterals    = d->plan->whatToCheck().testFlag( CppParserSettings::CheckStringLiterals );
+  const bool checkComments    = d->plan->whatToCheck().testFlag( CppParserSettings::CheckComments );
+  const QByteArrayView source = d->lexer->source();
+  QVector<WordTokens> wordTokens;
+  for( const CppSourceLexer::Token& token: std::as_const( sourceTokens ) ) {
+    WordTokens::Type type = WordTokens::Type::Literal;
+    if( token.isStringLiteral() == true ) {
+      if( checkLiterals == false ) {
+        continue;
+      }
+    } else {
+      if( checkComments == false ) {
         continue;
       }
-      wordsInSource += getListOfWordsFromSourceRecursive( curSymbol, overview );
+      if( ( d->plan->commentsToCheck().testFlag( CppParserSettings::CommentsC ) == false )
+          && ( token.kind == CPlusPlus::T_COMMENT ) ) {
+        continue;
+      }
+      if( ( d->plan->commentsToCheck().testFlag( CppParserSettings::CommentsCpp ) == false )
+          && ( token.kind == CPlusPlus::T_CPP_COMMENT ) ) {
+        continue;
+      }
+      type = ( ( token.kind == CPlusPlus::T_DOXY_COMMENT ) || ( token.kind == CPlusPlus::T_CPP_DOXY_COMMENT ) )
+             ? WordTokens::Type::Doxygen
+             : WordTokens::Type::Comment;
     }
+    const QByteArrayView tokenBytes = source.sliced( token.bytesBegin, token.bytes ).trimmed();
+    wordTokens.append( parseTokenBytes( tokenBytes, token.line, token.column, type ) );
   }
-  return wordsInSource;
-}
-// --------------------------------------------------
-
-QStringSet CppDocumentProcessor::getPossibleNamesFromString( const QString& string ) const
-{
-  QStringSet wordSet;
-  static const QRegularExpression nameRegExp( QStringLiteral( "(\\w+)" ) );
-  QRegularExpressionMatchIterator i = nameRegExp.globalMatch( string );
-  while( i.hasNext() ) {
-    const QRegularExpressionMatch match = i.next();
-    wordSet += match.captured( 1 );
-  }
-  return wordSet;
+  return wordTokens;
 }
 // --------------------------------------------------
 
@@ -258,10 +390,19 @@ WordTokens CppDocumentProcessor::parseToken( const CPlusPlus::Token& token, Word
 {
   int32_t line;
   int32_t col;
-  /* Get the index of the token. The index is used to get the position of the token.
-   * Doing this first so that the token can be ignored if it is the first comment */
+  /* Get the index of the token. The index is used to get the position of the token. */
   const int32_t tokenBegin = token.utf16charsBegin();
   d->trUnit->getPosition( tokenBegin, &line, &col );
+  /* Get the bytes of the token, without copying them out of the source. The
+   * hash is calculated on the UTF-8 bytes so that a token is only decoded if
+   * it is not known yet. */
+  const QByteArray source = d->docPtr->utf8Source();
+  return parseTokenBytes( QByteArrayView( source ).sliced( token.bytesBegin(), token.bytes() ).trimmed(), line, col, type );
+}
+// --------------------------------------------------
+
+WordTokens CppDocumentProcessor::parseTokenBytes( QByteArrayView tokenBytes, int32_t line, int32_t col, WordTokens::Type type ) const
+{
   /* Check if the first comment should be be returned.
    * This will be checked for every token, including literals and doxygen
    * comments. The check relies on early return of the if, thus the options
@@ -271,179 +412,98 @@ WordTokens CppDocumentProcessor::parseToken( const CPlusPlus::Token& token, Word
   if( ( type == WordTokens::Type::Comment )
       && ( line == 1 )
       && ( col == 1 )
-      && ( d->settings.removeFirstComment == true ) ) {
+      && ( d->plan->removeFirstComment() == true ) ) {
     return {};
   }
-  /* Get the token string */
-  const QString tokenString = QString::fromUtf8( d->docPtr->utf8Source().mid( token.bytesBegin(), token.bytes() ).trimmed() );
-  /* Calculate the hash of the token string */
-  const uint32_t hash = qHash( tokenString );
+  /* Calculate the hash of the token bytes */
+  const uint64_t hash = tokenHash64( tokenBytes );
 
   /* Set up the known parts of the return structure.
    * The rest will be populated as needed below. */
-  WordTokens tokens;
+  WordTokens tokens( &d->arena );
   tokens.hash   = hash;
+  tokens.length = tokenBytes.size();
   tokens.column = col;
   tokens.line   = line;
-  tokens.string = tokenString;
   tokens.type   = type;
 
-  TmpOptional wordOpt = checkHash( tokens, hash );
-  if( wordOpt.first == true ) {
-    return wordOpt.second;
+  if( checkHash( tokens, hash ) == true ) {
+    return tokens;
+  }
+
+  /* Check if the same token was parsed before in any file. The seed of the
+   * hash contains everything else that changes the words of the token. */
+  const uint64_t seed = qHashMulti( d->plan->fingerprint(), int( type ) );
+  tokens.contentKey   = { tokenHash64Seeded( hash, seed ), tokens.length };
+  tokens.shareWords   = true;
+  const CppTokenContentCache::RelativeWordsPtr relativeWords = d->contentCache->find( tokens.contentKey );
+  if( relativeWords != nullptr ) {
+    tokens.words      = CppTokenContentCache::fromRelative( *relativeWords, line, col, d->fileName );
+    tokens.newHash    = false;
+    tokens.shareWords = false;
+    return tokens;
   }
 
   /* Token was not in the list of hashes.
-   * Tokenize the string to extract words that should be checked. */
-  tokens.words   = extractWordsFromString( tokenString, tokenBegin, type );
+   * Decode the token and tokenize the string to extract words that should
+   * be checked. */
+  tokens.string = QString::fromUtf8( tokenBytes );
+  extractWordsFromString( tokens.string, line, col, type, tokens.views );
   tokens.newHash = true;
   return tokens;
 }
 // --------------------------------------------------
 
-WordList CppDocumentProcessor::extractWordsFromString( const QString& string, int32_t stringStart, WordTokens::Type type ) const
+void CppDocumentProcessor::extractWordsFromString( QStringView string, int32_t stringLine, int32_t stringColumn, WordTokens::Type type, WordViewList& words ) const
 {
-  WordList wordTokens;
   const int32_t strLength = string.length();
-  bool busyWithWord       = false;
-  int32_t wordStartPos    = 0;
-  bool endOfWord          = false;
-
-  /* Iterate through all of the characters in the comment and extract words from them.
-   * Words are split up by non-word characters and is checked using the isEndOfCurrentWord()
-   * function. The end condition is deliberately set to continue past the length of the
-   * comment so that a word in progress is stopped and extracted when the comment ends */
-  for( int currentPos = 0; currentPos <= strLength; ++currentPos ) {
-    /* Check if the current character is the end of a word character. */
-    endOfWord = isEndOfCurrentWord( string, currentPos );
-    if( ( endOfWord == false ) && ( busyWithWord == false ) ) {
-      wordStartPos = currentPos;
-      busyWithWord = true;
-    }
 
-    if( ( busyWithWord == true ) && ( endOfWord == true ) ) {
-      /* Pre-condition sanity checks for debugging. The wordStartPos
-       * can not be 0 or negative. A comment or literal always starts
-       * with either a slash-star or slash-slash (comment) or inverted
-       * comma (literal), thus there must always be something else before
-       * the word starts.
-       *
-       * currentPos on the other hand can be at the end of the string
-       * for example with a single line comment (slash-slash).
-       */
-      SP_CHECK( wordStartPos > 0 );
-      Word word;
-      word.fileName  = d->fileName;
-      word.text      = string.mid( wordStartPos, currentPos - wordStartPos );
-      word.start     = wordStartPos;
-      word.end       = currentPos;
-      word.length    = currentPos - wordStartPos;
-      word.charAfter = ( currentPos < strLength )
-                       ? string.at( currentPos )
-                       : QLatin1Char( ' ' );
-      word.inComment = ( type != WordTokens::Type::Literal );
-      bool isDoxygenTag = false;
-      if( type == WordTokens::Type::Doxygen ) {
-        const QChar charBeforeStart = string.at( wordStartPos - 1 );
-        if( ( charBeforeStart == QLatin1Char( '\\' ) )
-            || ( charBeforeStart == QLatin1Char( '@' ) ) ) {
-          const QString& currentWord = word.text;
-          /* Classify it */
-          const int32_t doxyClass = CppEditor::classifyDoxygenTag( currentWord.unicode(), currentWord.size() );
-          if( doxyClass != CppEditor::T_DOXY_IDENTIFIER ) {
-            /* It is a doxygen tag, mark it as such so that it does not end up
-             * in the list of words from this string. */
-            isDoxygenTag = true;
-          }
+  /* Iterate through all of the words in the comment. The tokenizer finds the
+   * words by splitting on the characters that are the end of a word, see
+   * CppWordTokenizer::isEndOfWord(). The words are found in order, thus
+   * their positions are mapped with a cursor that only moves forward. */
+  CppLinePositionCursor cursor( string, stringLine, stringColumn );
+  qsizetype currentPos   = 0;
+  qsizetype wordStartPos = 0;
+  while( d->tokenizer.nextWord( string, currentPos, wordStartPos ) == true ) {
+    /* Pre-condition sanity checks for debugging. The wordStartPos
+     * can not be 0 or negative. A comment or literal always starts
+     * with either a slash-star or slash-slash (comment) or inverted
+     * comma (literal), thus there must always be something else before
+     * the word starts.
+     *
+     * currentPos on the other hand can be at the end of the string
+     * for example with a single line comment (slash-slash).
+     */
+    SP_CHECK( wordStartPos > 0 );
+    WordView word;
+    word.text       = string.sliced( wordStartPos, currentPos - wordStartPos );
+    word.start      = wordStartPos;
+    word.charBefore = ( wordStartPos > 0 )
+                      ? string.at( wordStartPos - 1 )
+                      : QChar();
+    word.charAfter  = ( currentPos < strLength )
+                      ? string.at( currentPos )
+                      : QLatin1Char( ' ' );
+    word.inComment = ( type != WordTokens::Type::Literal );
+    bool isDoxygenTag = false;
+    if( type == WordTokens::Type::Doxygen ) {
+      if( ( word.charBefore == QLatin1Char( '\\' ) )
+          || ( word.charBefore == QLatin1Char( '@' ) ) ) {
+        /* Classify it */
+        const int32_t doxyClass = CppEditor::classifyDoxygenTag( word.text.data(), int( word.text.size() ) );
+        if( doxyClass != CppEditor::T_DOXY_IDENTIFIER ) {
+          /* It is a doxygen tag, mark it as such so that it does not end up
+           * in the list of words from this string. */
+          isDoxygenTag = true;
         }
       }
-      if( isDoxygenTag == false ) {
-        d->trUnit->getPosition( stringStart + uint32_t( wordStartPos ), &word.lineNumber, &word.columnNumber );
-        wordTokens.append( std::move( word ) );
-      }
-      busyWithWord = false;
-      wordStartPos = 0;
-    }
-  }
-  return wordTokens;
-}
-// --------------------------------------------------
-
-bool CppDocumentProcessor::isEndOfCurrentWord( const QString& comment, int currentPos ) const
-{
-  /* Check to see if the current position is past the length of the comment. If this
-   * is the case, then clearly it is the end of the current word */
-  if( currentPos >= comment.length() ) {
-    return true;
-  }
-
-  const QChar& currentChar = comment[currentPos];
-
-  /* Check if the current character is a letter, number or underscore.
-   * Some settings might change what the end of a word actually is.
-   * For some settings an underscore will be considered as the end of a word */
-  if( ( currentChar.isLetterOrNumber() == true )
-      || ( currentChar == QLatin1Char( '_' ) ) ) {
-    return false;
-  }
-
-  /* Check for an apostrophe in a word. This is for words like we're. Not all
-   * apostrophes are part of a word, like words that starts with and end with */
-  if( currentChar == QLatin1Char( '\'' ) ) {
-    /* Do some range checking, is this is the first or last character then
-     * this is not part of a word, thus it is the end of the current word */
-    if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
-      return true;
-    }
-    if( ( comment.at( currentPos + 1 ).isLetter() == true )
-        && ( comment.at( currentPos - 1 ).isLetter() == true ) ) {
-      return false;
     }
-  }
-
-  /* For words with '.' in, such as abbreviations and email addresses */
-  if( currentChar == QLatin1Char( '.' ) ) {
-    if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
-      return true;
-    }
-    static const QRegularExpression wordChars( QStringLiteral( "\\w" ) );
-    if( ( wordChars.match( comment.at( currentPos + 1 ) ).hasMatch() )
-        && ( wordChars.match( comment.at( currentPos - 1 ) ).hasMatch() ) ) {
-      return false;
+    if( isDoxygenTag == false ) {
+      cursor.position( wordStartPos, word.lineNumber, word.columnNumber );
+      words.push_back( word );
     }
   }
-
-  /* For word with @ in: Email address */
-  if( currentChar == QLatin1Char( '@' ) ) {
-    if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
-      return true;
-    }
-    static const QRegularExpression wordChars( QStringLiteral( "\\w" ) );
-    if( ( wordChars.match( comment.at( currentPos + 1 ) ).hasMatch() )
-        && ( wordChars.match( comment.at( currentPos - 1 ) ).hasMatch() ) ) {
-      return false;
-    }
-  }
-
-  /* Check for websites. This will only check the website characters if the
-   * option for website addresses are enabled due to the amount of false positives
-   * that this setting can remove. Also this can put some overhead to other settings
-   * that are not always desired.
-   * This setting might require some rework in the future. */
-  if( d->settings.removeWebsites == true ) {
-    static const QRegularExpression websiteChars( QStringLiteral( "\\w|" ) + QLatin1String( Parsers::CppParser::Constants::WEBSITE_CHARS_REGEXP_PATTERN ) );
-    if( websiteChars.match( currentChar ).hasMatch() == true ) {
-      if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
-        return true;
-      }
-      if( ( websiteChars.match( comment.at( currentPos + 1 ) ).hasMatch() == true )
-          && ( websiteChars.match( comment.at( currentPos - 1 ) ).hasMatch() == true ) ) {
-        return false;
-      }
-    }
-  }
-
-  return true;
 }
 // --------------------------------------------------
 
@@ -470,6 +530,8 @@ QVector<WordTokens> CppDocumentProcessor::parseMacros() const
     return {};
   }
   const QByteArray source = cppEditorDocument->contents();
+  /* The lines of the source are found once, for all of the macros. */
+  const CppLineOffsetTable lineOffsets( source );
 
   for( const CPlusPlus::Document::MacroUse& mac: macroUse ) {
     if( mac.isFunctionLike() == false ) {
@@ -484,15 +546,10 @@ QVector<WordTokens> CppDocumentProcessor::parseMacros() const
        * further. */
       continue;
     }
-    /* The line number of the macro is used as the reference. */
-    uint32_t line = mac.beginLine();
-    /* Get the start of the line from the source. From this start the offset to the
-     * words will be calculated. This start should never be -1 since
-     * a line will always start with a newline, and it seems like a macro
-     * will never start on the first line of the source file.
-     * Added a debug assert just to ensure this. */
-    const uint32_t start = uint32_t( source.lastIndexOf( '\n', int32_t( mac.utf16charsBegin() ) ) );
-    SP_CHECK( source.lastIndexOf( '\n', int32_t( mac.utf16charsBegin() ) ) > 0 );
+    /* Get the start of the line of the macro from the source. From this start the offset
+     * to the words will be calculated. */
+    const int32_t macroLine = lineOffsets.lineAt( mac.utf16charsBegin() );
+    const uint32_t start    = uint32_t( lineOffsets.lineStart( macroLine ) );
     /* Get the end index of the last argument of the macro. */
     const uint32_t end = args.last().utf16charsEnd();
     SP_CHECK( start < end );
@@ -515,87 +572,60 @@ QVector<WordTokens> CppDocumentProcessor::parseMacros() const
      * in the list of known hashes. The hash is calculated from the
      * start of the macro and not the line so that the movement of the
      * macro due to edits before the macro can be handled using the hash
-     * functionality.*/
-    WordTokens tokens;
-    tokens.column  = mac.utf16charsBegin() - start;
-    tokens.line    = line;
-    tokens.string  = QString::fromUtf8( macroBytes.mid( int32_t( mac.utf16charsBegin() - start ) ) );
-    tokens.hash    = qHash( tokens.string );
+     * functionality. The bytes are hashed as is, without decoding them.*/
+    const QByteArrayView macroFromStart = QByteArrayView( macroBytes ).sliced( mac.utf16charsBegin() - start );
+    WordTokens tokens( &d->arena );
+    tokens.column  = mac.utf16charsBegin() - start + 1;
+    tokens.line    = mac.beginLine();
+    tokens.hash    = tokenHash64( macroFromStart );
+    tokens.length  = macroFromStart.size();
     tokens.type    = WordTokens::Type::Literal;
     tokens.newHash = true;
 
-    TmpOptional wordOpt = checkHash( tokens, tokens.hash );
-    if( wordOpt.first == true ) {
-      tokenizedWords.append( wordOpt.second );
+    if( checkHash( tokens, tokens.hash ) == true ) {
+      tokenizedWords.append( std::move( tokens ) );
       continue;
     }
 
-    /* Get the byte offsets inside the macro bytes for each line break inside the macro.
-     * This will be used during the extraction to get the correct lines relative to the
-     * line that the macro started on. */
-    QVector<uint32_t> lineIndexes;
-    /* The search above for the start include the new line character so the start for other
-     * new lines must start from index 1 so that it is not also included. */
-    int32_t startSearch = 1;
-    while( true ) {
-      int idx = macroBytes.indexOf( '\n', startSearch );
-      if( idx < 0 ) {
-        /* No more new lines, break out */
-        break;
-      }
-      lineIndexes << uint32_t( idx );
-      /* Must increment the start of the next search otherwise it will be found on
-       * that index. */
-      startSearch = idx + 1;
-    }
-    /* The end is also added to simplify some of the checks further on. No character can
-     * fall outside of the end. */
-    lineIndexes << uint32_t( end );
-    uint32_t lineBreak = lineIndexes.takeFirst();
-    uint32_t colOffset = 0;
-
     /* Use a regular expression to get all string literals from the macro and its arguments. */
     static const QRegularExpression regExp( QStringLiteral( "\"([^\"\\\\]|\\\\.)*\"" ) );
-    QRegularExpressionMatchIterator regExpIter = regExp.globalMatch( QString::fromLatin1( macroBytes ) );
+    const QString macroString                  = QString::fromLatin1( macroBytes );
+    QRegularExpressionMatchIterator regExpIter = regExp.globalMatch( macroString );
     while( regExpIter.hasNext() == true ) {
       const QRegularExpressionMatch match = regExpIter.next();
-      const QString tokenString           = match.captured( 0 );
+      /* The words are views into the literal, thus the literal is copied to the
+       * arena so that it stays valid after the macro string is gone. */
+      const QStringView tokenString = d->copyToArena( match.capturedView( 0 ) );
       SP_CHECK( match.capturedStart( 0 ) >= 0 );
-      const uint32_t capStart = uint32_t( match.capturedStart( 0 ) );
-      /* Check if the literal starts on the next line from the current one */
-      while( capStart > lineBreak ) {
-        /* Increase the line number and reset the column offset */
-        ++line;
-        colOffset = lineBreak;
-        lineBreak = lineIndexes.takeFirst();
-      }
-      /* Get the words from the extracted literal */
-      WordList words = extractWordsFromString( tokenString, 0, WordTokens::Type::Literal );
-      for( Word& word: words ) {
-        /* Apply the offsets to the words */
-        word.columnNumber += capStart - colOffset;
-        word.lineNumber    = line;
-      }
-      tokens.words.append( words );
+      /* Get the line and column of the literal from the lines of the source. The
+       * line is relative to the line that the macro starts on. */
+      const qsizetype literalStart = qsizetype( start ) + match.capturedStart( 0 );
+      const int32_t literalLine    = lineOffsets.lineAt( literalStart );
+      const int32_t line           = int32_t( mac.beginLine() ) + ( literalLine - macroLine );
+      const int32_t column         = int32_t( literalStart - lineOffsets.lineStart( literalLine ) ) + 1;
       /* Get the words from the extracted literal */
+      extractWordsFromString( tokenString, line, column, WordTokens::Type::Literal, tokens.views );
     }
-    if( tokens.words.count() != 0 ) {
-      tokenizedWords.append( tokens );
+    if( tokens.views.empty() == false ) {
+      tokenizedWords.append( std::move( tokens ) );
     }
   }
   return tokenizedWords;
 }
 // --------------------------------------------------
 
-CppDocumentProcessor::TmpOptional CppDocumentProcessor::checkHash( WordTokens tokens, uint32_t hash ) const
+bool CppDocumentProcessor::checkHash( WordTokens& tokens, uint64_t hash ) const
 {
   /* Search if the hash contains the given token. If it does
    * then the words that got extracted previously are used
    * as is, without attempting to extract them again. If the
    * token is not in the hash, it is a new token and must be
    * parsed to get the words from the token. */
-  HashWords::const_iterator iter          = d->tokenHashes.constFind( hash );
-  const HashWords::const_iterator iterEnd = d->tokenHashes.constEnd();
+  if( d->tokenHashes == nullptr ) {
+    return false;
+  }
+  HashWords::const_iterator iter          = d->tokenHashes->constFind( hash );
+  const HashWords::const_iterator iterEnd = d->tokenHashes->constEnd();
   if( iter != iterEnd ) {
     /* The token was parsed in a previous iteration.
      * Now check if the token moved due to lines being
@@ -604,13 +634,19 @@ CppDocumentProcessor::TmpOptional CppDocumentProcessor::checkHash( WordTokens to
      * column number of the words by the amount that the
      * token moved. */
     const TokenWords& tokenWords = ( iter.value() );
+    if( tokenWords.length != tokens.length ) {
+      /* The hashes are the same but the tokens are not, this is a
+       * different token and it must be parsed. */
+      return false;
+    }
     if( ( tokenWords.line == tokens.line )
         && ( tokenWords.col == tokens.column ) ) {
       tokens.words   = tokenWords.words;
       tokens.newHash = false;
-      return std::make_pair( true, tokens );
+      return true;
     } else {
       WordList words;
+      words.reserve( tokenWords.words.size() );
       /* Token moved, adjust.
        * This will even work for lines that are copied because the
        * hash will be the same but the start will just be different. */
@@ -632,11 +668,11 @@ CppDocumentProcessor::TmpOptional CppDocumentProcessor::checkHash( WordTokens to
         }
         words.append( word );
       }
-      tokens.words   = words;
+      tokens.words   = std::move( words );
       tokens.newHash = false;
-      return std::make_pair( true, tokens );
+      return true;
     }
   }
-  return std::make_pair( false, WordTokens{} );
+  return false;
 }
 // --------------------------------------------------
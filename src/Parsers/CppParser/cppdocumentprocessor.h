@@ -21,16 +21,15 @@
 #pragma once
 
 #include "../../Word.h"
-#include "cppparsersettings.h"
+#include "cppidentifierindex.h"
+#include "cpptokencontentcache.h"
+#include "cpptokenhashcache.h"
+#include "cppwordfilterplan.h"
 
 #include <cplusplus/CppDocument.h>
 
 #include <QFuture>
 
-namespace CPlusPlus {
-class Overview;
-} // namespace CPlusPlus
-
 namespace SpellChecker {
 namespace CppSpellChecker {
 namespace Internal {
@@ -50,7 +49,20 @@ namespace Internal {
  *
  * The \a newHash flag keeps track if the words were extracted in a
  * previous pass or not, meaning that they were already processed and does not
- * need to be processed further. */
+ * need to be processed further.
+ *
+ * The token is hashed on its UTF-8 bytes in the source, the \a string is
+ * only decoded for tokens that are not known yet. Words of a new token are
+ * first extracted as \a views into the token string, allocated from the
+ * memory resource of the processor. Only the views that are kept after the
+ * settings were applied are converted to \a words.
+ *
+ * The \a words of a token are kept before the identifiers are removed, both
+ * in the hash of the file and in the content cache, since the identifiers
+ * change while the project is parsed.
+ *
+ * The words of comments and literals are shared with other files using
+ * the \a contentKey, if \a shareWords is set. */
 struct WordTokens
 {
   enum class Type {
@@ -59,13 +71,21 @@ struct WordTokens
     Literal
   };
 
+  WordTokens() = default;
+  explicit WordTokens( std::pmr::memory_resource* resource )
+    : views( resource ) {}
+
   HashWords::key_type hash;
-  int32_t line   = 0;
-  int32_t column = 0;
+  qsizetype length = 0; /*!< Length of the hashed token, in UTF-8 bytes. */
+  int32_t line     = 0;
+  int32_t column   = 0;
   QString string;
+  WordViewList views;
   WordList words;
   bool newHash = true;
   Type type;
+  CppTokenContentCache::Key contentKey;
+  bool shareWords = false;
 };
 
 class CppDocumentProcessorPrivate;
@@ -88,11 +108,23 @@ class CppDocumentProcessor
   /*! \brief Deleted assignment operator */
   CppDocumentProcessor& operator==( const CppDocumentProcessor& ) = delete;
 public:
-  /*! \brief Structure for the result type that the future will return. */
+  /*! \brief Structure for the result type that the future will return.
+   *
+   * The result can only be moved, it is taken from the future by the parser
+   * which then hands the words on to the spell checker without copying them. */
   struct ResultType
   {
+    ResultType() = default;
+    ResultType( HashWords&& hashes, WordListPtr&& wordList )
+      : wordHashes( std::move( hashes ) )
+      , words( std::move( wordList ) ) {}
+    ResultType( ResultType&& )                 = default;
+    ResultType& operator=( ResultType&& )      = default;
+    ResultType( const ResultType& )            = delete;
+    ResultType& operator=( const ResultType& ) = delete;
+
     HashWords wordHashes; /*!< List of hashes extracted along with words from the hash. */
-    WordList words;       /*!< Word tokens that were extracted by the processor. */
+    WordListPtr words;    /*!< Word tokens that were extracted by the processor. */
   };
   /*! \brief Alias for the Watcher type. */
   using Watcher = QFutureWatcher<ResultType>;
@@ -106,10 +138,34 @@ public:
    * Construct the processor for he given document, hashes for a speedup and
    * the settings that should be applied.
    * \param documentPointer Shared ownership of the document pointer to prevent
-   *    it from getting deleted while the processor still runs.
-   * \param hashWords List of hashes that should be used to optimise the parsing.
-   * \param cppSettings Settings that should be applied. */
-  CppDocumentProcessor( CPlusPlus::Document::Ptr documentPointer, const HashWords& hashWords, const CppParserSettings& cppSettings );
+   *    it from getting deleted while the processor still runs. The caller must
+   *    already have kept the source and AST of the document, see
+   *    CPlusPlus::Document::keepSourceAndAST(), the processor releases them
+   *    once it is done.
+   * \param hashWords Hashes of the previous pass over the document that should
+   *    be used to optimise the parsing, or nullptr if there are none. The
+   *    hashes are a shared snapshot and are not changed.
+   * \param filterPlan Plan of the settings that should be applied. The plan is
+   *    shared with the parser and the other processors.
+   * \param identifierIndex Project wide index of identifiers. The index is
+   *    updated with the identifiers of the document if the words that appear
+   *    in the source must be removed.
+   * \param tokenContentCache Words of tokens by their content, shared by all files.
+   *    Tokens that are not in the \a hashWords are looked up in this cache
+   *    before they are parsed. */
+  CppDocumentProcessor( CPlusPlus::Document::Ptr documentPointer, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache );
+  /*! \brief Constructor
+   *
+   * Construct the processor for a file that is not open in an editor. The
+   * file is lexed from disk with the CppSourceLexer, without waiting for the
+   * code model to parse it.
+   * \param fileName File that must be processed.
+   * \param identifierDocument Document of the code model for the file, if it
+   *    is up to date with the file on disk. It is only used for its
+   *    identifiers, its source can already be released. Can be null, then the
+   *    identifiers are collected by the lexer.
+   * The rest of the parameters are the same as for the document constructor. */
+  CppDocumentProcessor( const QString& fileName, CPlusPlus::Document::Ptr identifierDocument, const HashWordsPtr& hashWords, const CppWordFilterPlanPtr& filterPlan, const CppIdentifierIndexPtr& identifierIndex, const CppTokenContentCachePtr& tokenContentCache );
   /*! Destructor. */
   ~CppDocumentProcessor();
   /*! \brief Process function that the thread will run with the future that will
@@ -117,10 +173,20 @@ public:
   void process( Promise& promise );
 
 private:
-  QStringSet getWordsThatAppearInSource() const;
-  QStringSet getListOfWordsFromSourceRecursive( const CPlusPlus::Symbol* symbol, const CPlusPlus::Overview& overview ) const;
-  QStringSet getPossibleNamesFromString( const QString& string ) const;
-
+  /*! \brief Get the tokens of the document of the code model.
+   *
+   * String literals, the string literals in the arguments of macros and the
+   * comments are parsed, depending on the settings.
+   * \return Tokens of the document, or an empty list if the processing was
+   *              canceled. */
+  QVector<WordTokens> parseDocument( Promise& promise ) const;
+  /*! \brief Get the tokens of a file that is lexed from disk.
+   *
+   * The same settings are applied as for a document. The identifiers of the
+   * file are taken from the lexer to update the identifier index.
+   * \return Tokens of the file, or an empty list if the processing was
+   *              canceled or the file could not be read. */
+  QVector<WordTokens> parseSource( Promise& promise ) const;
   /*! \brief Parse a Token retrieved from the Translation Unit of the document.
    *
    * Since both Comments and String Literals are tokens, the common code to extract the
@@ -141,6 +207,10 @@ private:
    *
    * \param[in] token Translation Unit Token that should be split up into words that
    *              should be checked.
+   * If the token is not in the hash, the words of the same token in any file
+   * are looked up in the content cache. Those words only need their positions
+   * fixed up.
+   *
    * \param[in] type If the token is a Comment, Doxygen Documentation or a
    *              String Literal. This is captured to go along with the
    *              word so that the tables and displays upstream can indicate
@@ -150,32 +220,33 @@ private:
    * \return WordTokens structure containing enough information to be useful to
    *              the caller. */
   WordTokens parseToken( const CPlusPlus::Token& token, WordTokens::Type type ) const;
+  /*! \brief Parse the bytes of a token.
+   *
+   * Common part of parseToken() and parseSource(), once the position and the
+   * UTF-8 bytes of the token are known.
+   * \param[in] tokenBytes UTF-8 bytes of the token, trimmed.
+   * \param[in] line Line of the token.
+   * \param[in] col Column of the token.
+   * \param[in] type Type of the token, see parseToken(). */
+  WordTokens parseTokenBytes( QByteArrayView tokenBytes, int32_t line, int32_t col, WordTokens::Type type ) const;
   /*! \brief Extract Words from the given string.
    *
    * This function takes a string, either a comment or a string literal and
    * breaks the string into words or tokens that should later be checked
    * for spelling mistakes.
    * \param[in] string String that must be broken up into words.
-   * \param[in] stringStart Start of the string.
+   * \param[in] stringLine Line of the start of the string.
+   * \param[in] stringColumn Column of the start of the string. The positions
+   *              of the words are mapped from the start of the string.
    * \param[in] type If the string is a Comment, Doxygen Documentation or a
    *              String Literal. If the string is Doxygen docs then the
    *              function will also try to remove doxygen tags from the words
    *              extracted. This reduce the number of words returned that
    *              gets handled later on, and it does not rely on a setting,
    *              it must be done always to remove noise.
-   * \return Words that were extracted from the string. */
-  WordList extractWordsFromString(const QString& string, int32_t stringStart, WordTokens::Type type ) const;
-  /*! \brief Check if the end of a possible word was reached.
-   *
-   * Utility function to check if the character at the given position is the
-   * end of a word. The end of a word for example is a space There
-   * are some handling of dots and other characters that determine if the
-   * position is the end of the word.
-   *
-   * \todo Check if isEndOfCurrentWord can not be re-implemented
-   * using an iterator instead of an index. This would possibly require
-   * rework in the calling function as well, but might be cleaner. */
-  bool isEndOfCurrentWord( const QString& comment, int currentPos ) const;
+   * \param[out] words Words that were extracted from the string are added to
+   *              this list. The words are views into the \a string.  */
+  void extractWordsFromString( QStringView string, int32_t stringLine, int32_t stringColumn, WordTokens::Type type, WordViewList& words ) const;
   /*! \brief Parse all macros in the document and extract string literals.
    *
    * Only macros that are functions and have arguments that are string literals
@@ -183,10 +254,6 @@ private:
    * there are also other macros that takes in literals as arguments. */
   QVector<WordTokens> parseMacros() const;
 
-  /*! \brief Custom type for the checkHash() return type.
-   *
-   * If C++17 is used this should be replaced by a std::optional. */
-  using TmpOptional = std::pair<bool, WordTokens>;
   /*! \brief Optimisation function to check a hash.
    *
    * An optimisation is done where a token string is extracted and
@@ -207,8 +274,17 @@ private:
    * multiple times in the same file, it can just re-use the words
    * without any more processing on the second string. The usefulness
    * of this is probably not much since strings should not normally repeat.
-   * People should use the DRY principal... */
-  TmpOptional checkHash( WordTokens tokens, uint32_t hash ) const;
+   * People should use the DRY principal...
+   *
+   * The hash is a strong 64-bit hash, see tokenHash64(). The length of the
+   * token is also compared, so that the rare collision does not attach the
+   * words of another token to this token.
+   *
+   * \param[in,out] tokens Tokens with the position of the token. If the hash
+   *              is known, the words of the token are set on it.
+   * \param[in] hash Hash of the token.
+   * \return True if the hash was known and the words were set. */
+  bool checkHash( WordTokens& tokens, uint64_t hash ) const;
 
   friend CppDocumentProcessorPrivate;
   CppDocumentProcessorPrivate* const d;
@@ -0,0 +1,130 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cppidentifierindex.h"
+
+#include <cplusplus/Control.h>
+#include <cplusplus/Literals.h>
+
+using namespace SpellChecker;
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+void CppIdentifierIndex::update( const CPlusPlus::Document::Ptr& document )
+{
+  const QString fileName  = document->filePath().toString();
+  const unsigned revision = document->revision();
+  {
+    QReadLocker locker( &d_lock );
+    const auto iter = d_documents.constFind( fileName );
+    if( ( iter != d_documents.cend() ) && ( iter->revision == revision ) ) {
+      return;
+    }
+  }
+
+  /* Collect the identifiers without holding the lock. The control of the
+   * document contains each identifier of the translation unit once, thus
+   * there is no need to walk the symbols of the document. */
+  DocumentIdentifiers newIdentifiers;
+  newIdentifiers.revision = revision;
+  const CPlusPlus::Control* control = document->control();
+  if( control != nullptr ) {
+    for( auto iter = control->firstIdentifier(); iter != control->lastIdentifier(); ++iter ) {
+      const CPlusPlus::Identifier* identifier = *iter;
+      newIdentifiers.identifiers.append( QString::fromUtf8( identifier->chars(), int( identifier->size() ) ) );
+    }
+  }
+
+  replaceIdentifiers( fileName, std::move( newIdentifiers ) );
+}
+// --------------------------------------------------
+
+void CppIdentifierIndex::update( const QString& fileName, QStringList identifiers )
+{
+  /* A source that was not parsed by the code model does not have a revision,
+   * revision 0 is never used by the code model. */
+  DocumentIdentifiers newIdentifiers;
+  newIdentifiers.revision    = 0;
+  newIdentifiers.identifiers = std::move( identifiers );
+  replaceIdentifiers( fileName, std::move( newIdentifiers ) );
+}
+// --------------------------------------------------
+
+void CppIdentifierIndex::replaceIdentifiers( const QString& fileName, DocumentIdentifiers&& newIdentifiers )
+{
+  QWriteLocker locker( &d_lock );
+  DocumentIdentifiers& documentIdentifiers = d_documents[fileName];
+  removeIdentifiers( documentIdentifiers.identifiers );
+  for( QString& identifier: newIdentifiers.identifiers ) {
+    auto iter = d_identifiers.find( identifier );
+    if( iter == d_identifiers.end() ) {
+      iter = d_identifiers.insert( identifier, 0 );
+    }
+    ++iter.value();
+    /* Share the string with the key in the index. */
+    identifier = iter.key();
+  }
+  documentIdentifiers = std::move( newIdentifiers );
+}
+// --------------------------------------------------
+
+void CppIdentifierIndex::removeFiles( const QStringSet& fileNames )
+{
+  QWriteLocker locker( &d_lock );
+  for( const QString& fileName: fileNames ) {
+    const auto iter = d_documents.find( fileName );
+    if( iter != d_documents.end() ) {
+      removeIdentifiers( iter->identifiers );
+      d_documents.erase( iter );
+    }
+  }
+}
+// --------------------------------------------------
+
+void CppIdentifierIndex::clear()
+{
+  QWriteLocker locker( &d_lock );
+  d_documents.clear();
+  d_identifiers.clear();
+}
+// --------------------------------------------------
+
+bool CppIdentifierIndex::contains( QStringView word ) const
+{
+  /* The word is wrapped in a string without copying it for the lookup. */
+  const QString key = QString::fromRawData( word.data(), word.size() );
+  QReadLocker locker( &d_lock );
+  return d_identifiers.contains( key );
+}
+// --------------------------------------------------
+
+void CppIdentifierIndex::removeIdentifiers( const QStringList& identifiers )
+{
+  /* The lock must be held for writing by the caller. */
+  for( const QString& identifier: identifiers ) {
+    const auto iter = d_identifiers.find( identifier );
+    if( iter == d_identifiers.end() ) {
+      continue;
+    }
+    if( --iter.value() == 0 ) {
+      d_identifiers.erase( iter );
+    }
+  }
+}
+// --------------------------------------------------
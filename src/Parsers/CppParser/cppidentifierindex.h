@@ -0,0 +1,97 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "../../Word.h"
+
+#include <cplusplus/CppDocument.h>
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QStringView>
+
+#include <memory>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief The C++ Identifier Index class.
+ *
+ * Index of the identifiers that appear in the source of the documents of a
+ * project. The index is shared by all of the files, thus an identifier
+ * that appears in one file, for example a header, is also known in the
+ * other files.
+ *
+ * The index is updated for each revision of a document from the
+ * identifiers of the translation unit of the document. The identifiers of
+ * the previous revision of the document are replaced, an identifier stays
+ * in the index while any document still contains it.
+ *
+ * The index can be used from any thread. */
+class CppIdentifierIndex
+{
+public:
+  CppIdentifierIndex() = default;
+  CppIdentifierIndex( const CppIdentifierIndex& )            = delete;
+  CppIdentifierIndex& operator=( const CppIdentifierIndex& ) = delete;
+
+  /*! \brief Update the identifiers of the document.
+   *
+   * Nothing is done if the index already contains this revision of the
+   * document. */
+  void update( const CPlusPlus::Document::Ptr& document );
+  /*! \brief Update the identifiers of the file, from a source that was not
+   * parsed by the code model.
+   *
+   * The identifiers always replace the previous identifiers of the file.
+   * \param[in] fileName File that the identifiers appear in.
+   * \param[in] identifiers Identifiers of the file, each one once. */
+  void update( const QString& fileName, QStringList identifiers );
+  /*! \brief Remove the identifiers of the files from the index. */
+  void removeFiles( const QStringSet& fileNames );
+  /*! \brief Remove all identifiers from the index. */
+  void clear();
+  /*! \brief Check if the word is an identifier in any of the documents. */
+  bool contains( QStringView word ) const;
+
+private:
+  /*! \brief Identifiers of a single document. */
+  struct DocumentIdentifiers
+  {
+    unsigned revision = 0;
+    QStringList identifiers;
+  };
+
+  void replaceIdentifiers( const QString& fileName, DocumentIdentifiers&& newIdentifiers );
+  void removeIdentifiers( const QStringList& identifiers );
+
+  mutable QReadWriteLock d_lock;
+  QHash<QString, DocumentIdentifiers> d_documents; /*!< Identifiers of each file. */
+  QHash<QString, int32_t> d_identifiers;           /*!< Number of files that contain each identifier. */
+};
+
+/*! \brief Shared identifier index. */
+using CppIdentifierIndexPtr = std::shared_ptr<CppIdentifierIndex>;
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
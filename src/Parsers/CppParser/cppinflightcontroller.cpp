@@ -0,0 +1,150 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cppinflightcontroller.h"
+
+#include <QThread>
+
+#include <algorithm>
+
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+/*! \brief Weight of a new time in the average time of a file. */
+constexpr double LATENCY_WEIGHT = 0.125;
+/*! \brief Weight with which the base time follows a slower average time,
+ * once per window.
+ *
+ * The base time is the fastest average time, but it slowly follows the
+ * average so that a few very fast files do not shrink the window forever. */
+constexpr double BASE_LATENCY_WEIGHT = 1.0 / 64.0;
+/*! \brief The machine is busy if files take longer than this factor times the
+ * base time. */
+constexpr double BUSY_FACTOR = 2.0;
+/*! \brief The window may grow while files take less than this factor times
+ * the base time. */
+constexpr double IDLE_FACTOR = 1.25;
+
+CppInFlightController::CppInFlightController( int32_t minimum, int32_t maximum )
+  : d_minimum( std::max( minimum, 1 ) )
+  , d_maximum( std::max( maximum, d_minimum ) )
+  , d_window( std::clamp( QThread::idealThreadCount(), d_minimum, d_maximum ) )
+{
+  d_clock.start();
+}
+// --------------------------------------------------
+
+int32_t CppInFlightController::windowSize() const
+{
+  QMutexLocker locker( &d_mutex );
+  return d_window;
+}
+// --------------------------------------------------
+
+void CppInFlightController::setLimits( int32_t minimum, int32_t maximum )
+{
+  QMutexLocker locker( &d_mutex );
+  d_minimum = std::max( minimum, 1 );
+  d_maximum = std::max( maximum, d_minimum );
+  d_window  = std::clamp( d_window, d_minimum, d_maximum );
+}
+// --------------------------------------------------
+
+void CppInFlightController::started( const QString& fileName )
+{
+  QMutexLocker locker( &d_mutex );
+  d_started.insert( fileName, d_clock.nsecsElapsed() );
+}
+// --------------------------------------------------
+
+void CppInFlightController::finished( const QString& fileName, qsizetype queueDepth )
+{
+  QMutexLocker locker( &d_mutex );
+  const auto iter = d_started.find( fileName );
+  if( iter == d_started.end() ) {
+    /* The processor was cancelled, the files in flight were cleared. */
+    return;
+  }
+  const qint64 latency = d_clock.nsecsElapsed() - iter.value();
+  d_started.erase( iter );
+  adapt( latency, queueDepth );
+}
+// --------------------------------------------------
+
+void CppInFlightController::dropped( const QString& fileName )
+{
+  QMutexLocker locker( &d_mutex );
+  d_started.remove( fileName );
+}
+// --------------------------------------------------
+
+void CppInFlightController::clear()
+{
+  QMutexLocker locker( &d_mutex );
+  d_started.clear();
+  d_finishedInWindow = 0;
+}
+// --------------------------------------------------
+
+CppInFlightController::Statistics CppInFlightController::statistics() const
+{
+  QMutexLocker locker( &d_mutex );
+  Statistics stats;
+  stats.windowSize = d_window;
+  stats.inFlight   = int32_t( d_started.size() );
+  stats.latencyMs  = d_latency / 1e6;
+  stats.finished   = d_finished;
+  return stats;
+}
+// --------------------------------------------------
+
+void CppInFlightController::adapt( qint64 latency, qsizetype queueDepth )
+{
+  /* Keep the average time of a file and the base time, the time of a file
+   * when the machine is not busy. */
+  if( d_finished == 0 ) {
+    d_latency = double( latency );
+  } else {
+    d_latency += ( double( latency ) - d_latency ) * LATENCY_WEIGHT;
+  }
+  if( ( d_baseLatency == 0 ) || ( d_latency < d_baseLatency ) ) {
+    d_baseLatency = d_latency;
+  }
+  ++d_finished;
+
+  /* Only change the window once all of the files of the current window had
+   * the chance to finish. */
+  ++d_finishedInWindow;
+  if( d_finishedInWindow < d_window ) {
+    return;
+  }
+  d_finishedInWindow = 0;
+  d_baseLatency     += ( d_latency - d_baseLatency ) * BASE_LATENCY_WEIGHT;
+
+  if( d_latency > ( d_baseLatency * BUSY_FACTOR ) ) {
+    /* The machine is busy, shrink the window by a quarter. */
+    d_window = std::max( d_window - std::max( d_window / 4, 1 ), d_minimum );
+  } else if( ( d_latency < ( d_baseLatency * IDLE_FACTOR ) )
+             && ( queueDepth > d_window ) ) {
+    /* Files finish as fast as they can and there are enough files waiting
+     * to fill a larger window. */
+    d_window = std::min( d_window + std::max( d_window / 4, 1 ), d_maximum );
+  }
+}
+// --------------------------------------------------
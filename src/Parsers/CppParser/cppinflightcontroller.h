@@ -0,0 +1,115 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief The C++ In Flight Controller class.
+ *
+ * Controls the number of files that are in process at the same time, the
+ * in flight window. Files in process are either being parsed by the code
+ * model or by a processor, thus the right window depends on the machine and
+ * on what else is running on it.
+ *
+ * The window starts at the ideal thread count of the machine. The time from
+ * when the processor of a file is started until it is finished is measured.
+ * The time that a file waits for the code model is not part of it, it
+ * depends on the queue of the code model more than on the machine. While the files
+ * finish about as fast as the fastest that were seen and there are more files
+ * waiting, the window grows. If the files take a lot longer to finish than
+ * that, the machine is busy and the window shrinks. The window is only
+ * changed once per window of finished files, so that the effect of the
+ * previous change is seen first.
+ *
+ * The window always stays between the minimum and maximum that the user
+ * set. */
+class CppInFlightController
+{
+public:
+  /*! \brief Statistics of the controller. */
+  struct Statistics
+  {
+    int32_t windowSize = 0; /*!< Current size of the window. */
+    int32_t inFlight   = 0; /*!< Number of processors that are started and not finished. */
+    double latencyMs   = 0; /*!< Average time of the processor of a file, in milliseconds. */
+    uint64_t finished  = 0; /*!< Number of files that finished. */
+  };
+
+  /*! \brief Constructor
+   * \param[in] minimum Minimum size of the window.
+   * \param[in] maximum Maximum size of the window. */
+  CppInFlightController( int32_t minimum, int32_t maximum );
+  CppInFlightController( const CppInFlightController& )            = delete;
+  CppInFlightController& operator=( const CppInFlightController& ) = delete;
+
+  /*! \brief Get the number of files that may be in process at the same time. */
+  int32_t windowSize() const;
+  /*! \brief Set the minimum and maximum size of the window.
+   *
+   * If the \a maximum is less than the \a minimum, the \a minimum is used for
+   * both. */
+  void setLimits( int32_t minimum, int32_t maximum );
+  /*! \brief The processor of the file was started.
+   *
+   * If the file was already started, the time is measured from now, the
+   * previous processor of the file was replaced. */
+  void started( const QString& fileName );
+  /*! \brief The processor of the file finished.
+   *
+   * The time that the file took is used to adapt the window.
+   * \param[in] fileName File that finished.
+   * \param[in] queueDepth Number of files that are still waiting to be
+   *              started. */
+  void finished( const QString& fileName, qsizetype queueDepth );
+  /*! \brief The file will not finish, it is not measured. */
+  void dropped( const QString& fileName );
+  /*! \brief Forget all of the files that are in flight.
+   *
+   * The window and the measured times are kept. */
+  void clear();
+  /*! \brief Get the statistics of the controller. */
+  Statistics statistics() const;
+
+private:
+  void adapt( qint64 latency, qsizetype queueDepth );
+
+  mutable QMutex d_mutex;
+  QElapsedTimer d_clock;
+  QHash<QString, qint64> d_started; /*!< Start time of the files in flight. */
+  int32_t d_minimum;
+  int32_t d_maximum;
+  int32_t d_window;
+  double d_latency           = 0; /*!< Average time of a file, in nanoseconds. */
+  double d_baseLatency       = 0; /*!< Time of a file when the machine is not busy. */
+  uint64_t d_finished        = 0;
+  int32_t d_finishedInWindow = 0; /*!< Files finished since the window changed. */
+};
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
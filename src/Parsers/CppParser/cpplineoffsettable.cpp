@@ -0,0 +1,110 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cpplineoffsettable.h"
+
+#include <utils/qtcassert.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+namespace {
+/* Estimate of the average length of a line, used to reserve the table. */
+constexpr qsizetype AVERAGE_LINE_LENGTH = 32;
+} // namespace
+
+CppLineOffsetTable::CppLineOffsetTable( QByteArrayView source )
+{
+  d_lineStarts.reserve( ( source.size() / AVERAGE_LINE_LENGTH ) + 1 );
+  d_lineStarts.append( 0 );
+  const char* const begin = source.data();
+  const char* const end   = begin + source.size();
+  const char* pos         = begin;
+  /* memchr() is vectorized by the C library, much faster than checking each
+   * character. */
+  while( ( pos < end )
+         && ( ( pos = static_cast<const char*>( std::memchr( pos, '\n', std::size_t( end - pos ) ) ) ) != nullptr ) ) {
+    ++pos;
+    d_lineStarts.append( pos - begin );
+  }
+}
+// --------------------------------------------------
+
+int32_t CppLineOffsetTable::lineAt( qsizetype offset ) const
+{
+  if( offset < d_lineStarts.at( d_cursor ) ) {
+    /* Before the cursor, search from the start. */
+    const auto iter = std::upper_bound( d_lineStarts.cbegin(), d_lineStarts.cbegin() + d_cursor, offset );
+    d_cursor = int32_t( iter - d_lineStarts.cbegin() ) - 1;
+    return d_cursor;
+  }
+  /* Most of the time the offset is on the same or one of the next few lines,
+   * only search if it is further than that. */
+  constexpr int32_t NEARBY_LINES = 4;
+  const int32_t lastLine         = lineCount() - 1;
+  for( int32_t step = 0; step < NEARBY_LINES; ++step ) {
+    if( ( d_cursor == lastLine )
+        || ( offset < d_lineStarts.at( d_cursor + 1 ) ) ) {
+      return d_cursor;
+    }
+    ++d_cursor;
+  }
+  const auto iter = std::upper_bound( d_lineStarts.cbegin() + d_cursor, d_lineStarts.cend(), offset );
+  d_cursor = int32_t( iter - d_lineStarts.cbegin() ) - 1;
+  return d_cursor;
+}
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+CppLinePositionCursor::CppLinePositionCursor( QStringView string, int32_t line, int32_t column )
+  : d_string( string )
+  , d_line( line )
+  , d_column( column )
+  , d_lineStart( -1 )
+{}
+// --------------------------------------------------
+
+void CppLinePositionCursor::position( qsizetype position, int32_t& line, int32_t& column )
+{
+  QTC_ASSERT( position >= d_position, position = d_position );
+  /* Count the line breaks between the previous position and this one, only
+   * the part of the string in between is searched. */
+  while( d_position < position ) {
+    const qsizetype lineBreak = d_string.sliced( d_position, position - d_position ).indexOf( QLatin1Char( '\n' ) );
+    if( lineBreak < 0 ) {
+      break;
+    }
+    ++d_line;
+    d_position += lineBreak + 1;
+    d_lineStart = d_position;
+  }
+  d_position = position;
+
+  line = d_line;
+  /* Only the columns on the first line depend on the column of the start
+   * of the string. */
+  column = ( d_lineStart < 0 )
+           ? d_column + int32_t( position )
+           : int32_t( position - d_lineStart ) + 1;
+}
+// --------------------------------------------------
@@ -0,0 +1,97 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QStringView>
+#include <QVector>
+
+#include <cstdint>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief The C++ Line Offset Table class.
+ *
+ * Table of the offsets where each line of a source starts. The table is built
+ * once for a source, in a single scan for the line breaks using memchr(), and
+ * is then used for all of the positions in the source.
+ *
+ * Lines are looked up with a cursor that only moves forward, thus looking up
+ * positions in the order that they appear in the source does not need a
+ * search for each of the positions. Positions before the cursor fall back to
+ * a binary search. The table is not thread safe because of the cursor, it is
+ * meant to be used by the processor of a single document. */
+class CppLineOffsetTable
+{
+public:
+  /*! \brief Constructor
+   * \param[in] source Source of which the lines should be found. The table
+   *              does not keep a reference to the source. */
+  explicit CppLineOffsetTable( QByteArrayView source );
+
+  /*! \brief Number of lines in the source. */
+  int32_t lineCount() const { return int32_t( d_lineStarts.size() ); }
+  /*! \brief Get the line, starting at 0, that the \a offset is on. */
+  int32_t lineAt( qsizetype offset ) const;
+  /*! \brief Get the offset of the start of the \a line. */
+  qsizetype lineStart( int32_t line ) const { return d_lineStarts.at( line ); }
+
+private:
+  QVector<qsizetype> d_lineStarts;
+  mutable int32_t d_cursor = 0; /*!< Line of the last lookup. */
+};
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+/*! \brief The C++ Line Position Cursor class.
+ *
+ * Cursor that maps the positions inside a string, like a comment or literal,
+ * to line and column numbers. The line and column of the start of the string
+ * are known, the cursor only counts the line breaks between the previous
+ * position and the next one. The positions must be mapped in order. */
+class CppLinePositionCursor
+{
+public:
+  /*! \brief Constructor
+   * \param[in] string String of which the positions are mapped.
+   * \param[in] line Line of the start of the string.
+   * \param[in] column Column of the start of the string. */
+  CppLinePositionCursor( QStringView string, int32_t line, int32_t column );
+
+  /*! \brief Get the \a line and \a column of the \a position in the string.
+   *
+   * The \a position must not be before the position of the previous call. */
+  void position( qsizetype position, int32_t& line, int32_t& column );
+
+private:
+  QStringView d_string;
+  int32_t d_line;
+  int32_t d_column;         /*!< Column of the start of the string. */
+  qsizetype d_lineStart;    /*!< Start of the current line, -1 while on the first line. */
+  qsizetype d_position = 0; /*!< Position up to which the line breaks were counted. */
+};
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
@@ -45,6 +45,8 @@ const char REMOVE_EMAIL_ADDRESSES[] = "removeEmailAddresses";
 const char CHECK_DOTS[]             = "wordsWithDotsOption";
 const char REMOVE_WEBSITES[]        = "removeWebsites";
 const char REMOVE_FIRST_COMMENT[]   = "removeFirstComment";
+const char LEX_CLOSED_FILES[]       = "lexClosedFiles";
+const char USE_CODE_MODEL_SNAPSHOT[] = "useCodeModelSnapshot";
 
 } // namespace Constants
 } // namespace CppParser
@@ -97,6 +97,8 @@ const CppParserSettings& CppParserOptionsWidget::settings()
   m_settings.removeWordsThatAppearInSource = ui->checkBoxWordsInSource->isChecked();
   m_settings.removeWebsites                = ui->checkBoxWebsiteAddresses->isChecked();
   m_settings.removeFirstComment            = ui->checkBoxRemoveFirstComment->isChecked();
+  m_settings.lexClosedFiles                = ui->checkBoxLexClosedFiles->isChecked();
+  m_settings.useCodeModelSnapshot          = ui->checkBoxUseCodeModelSnapshot->isChecked();
   return m_settings;
 }
 // --------------------------------------------------
@@ -169,6 +171,8 @@ void CppParserOptionsWidget::updateWithSettings( const CppParserSettings* const
   dotsButtons[settings->wordsWithDotsOption]->setChecked( true );
   ui->checkBoxWebsiteAddresses->setChecked( settings->removeWebsites );
   ui->checkBoxRemoveFirstComment->setChecked( settings->removeFirstComment );
+  ui->checkBoxLexClosedFiles->setChecked( settings->lexClosedFiles );
+  ui->checkBoxUseCodeModelSnapshot->setChecked( settings->useCodeModelSnapshot );
 }
 // --------------------------------------------------
 
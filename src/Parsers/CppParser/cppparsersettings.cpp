@@ -49,6 +49,8 @@ CppParserSettings::CppParserSettings( const CppParserSettings& settings )
   wordsWithDotsOption           = settings.wordsWithDotsOption;
   removeWebsites                = settings.removeWebsites;
   removeFirstComment            = settings.removeFirstComment;
+  lexClosedFiles                = settings.lexClosedFiles;
+  useCodeModelSnapshot          = settings.useCodeModelSnapshot;
 }
 // --------------------------------------------------
 
@@ -76,6 +78,8 @@ void CppParserSettings::loadFromSettings( Utils::QtcSettings* settings )
   wordsWithDotsOption           = static_cast<WordsWithDotsOption>( settings->value( Parsers::CppParser::Constants::CHECK_DOTS, wordsWithDotsOption ).toInt() );
   removeWebsites                = settings->value( Parsers::CppParser::Constants::REMOVE_WEBSITES, removeWebsites ).toBool();
   removeFirstComment            = settings->value( Parsers::CppParser::Constants::REMOVE_FIRST_COMMENT, removeFirstComment ).toBool();
+  lexClosedFiles                = settings->value( Parsers::CppParser::Constants::LEX_CLOSED_FILES, lexClosedFiles ).toBool();
+  useCodeModelSnapshot          = settings->value( Parsers::CppParser::Constants::USE_CODE_MODEL_SNAPSHOT, useCodeModelSnapshot ).toBool();
 
   settings->endGroup(); /* CPP_PARSER_GROUP */
   settings->endGroup(); /* CORE_PARSERS_GROUP */
@@ -103,6 +107,8 @@ void CppParserSettings::saveToSetting(Utils::QtcSettings *settings ) const
   settings->setValue( Parsers::CppParser::Constants::CHECK_DOTS,             wordsWithDotsOption );
   settings->setValue( Parsers::CppParser::Constants::REMOVE_WEBSITES,        removeWebsites );
   settings->setValue( Parsers::CppParser::Constants::REMOVE_FIRST_COMMENT,   removeFirstComment );
+  settings->setValue( Parsers::CppParser::Constants::LEX_CLOSED_FILES,       lexClosedFiles );
+  settings->setValue( Parsers::CppParser::Constants::USE_CODE_MODEL_SNAPSHOT, useCodeModelSnapshot );
 
   settings->endGroup(); /* CPP_PARSER_GROUP */
   settings->endGroup(); /* CORE_PARSERS_GROUP */
@@ -125,6 +131,8 @@ void CppParserSettings::setDefaults()
   wordsWithDotsOption           = SplitWordsOnDots;
   removeWebsites                = false;
   removeFirstComment            = false;
+  lexClosedFiles                = false;
+  useCodeModelSnapshot          = true;
 }
 // --------------------------------------------------
 
@@ -144,6 +152,8 @@ CppParserSettings& CppParserSettings::operator=( const CppParserSettings& other
     this->wordsWithDotsOption           = other.wordsWithDotsOption;
     this->removeWebsites                = other.removeWebsites;
     this->removeFirstComment            = other.removeFirstComment;
+    this->lexClosedFiles                = other.lexClosedFiles;
+    this->useCodeModelSnapshot          = other.useCodeModelSnapshot;
     emit settingsChanged();
   }
 
@@ -166,6 +176,8 @@ bool CppParserSettings::operator==( const CppParserSettings& other ) const
   different = different | ( wordsWithDotsOption != other.wordsWithDotsOption );
   different = different | ( removeWebsites != other.removeWebsites );
   different = different | ( removeFirstComment != other.removeFirstComment );
+  different = different | ( lexClosedFiles != other.lexClosedFiles );
+  different = different | ( useCodeModelSnapshot != other.useCodeModelSnapshot );
   return ( different == false );
 }
 // --------------------------------------------------
@@ -147,6 +147,21 @@ public:
                                            * Doxygen comments that are the first comment in a file
                                            * will not be ignored. This is to handle pure doxygen
                                            * docs files that might start without a file header. */
+  bool lexClosedFiles;                    /*!< Files that are not open in an editor are lexed
+                                           * directly from disk instead of being parsed by the code
+                                           * model. This is a lot faster for large projects, but
+                                           * the code model is not used for these files, thus code
+                                           * that is disabled by the preprocessor is also checked.
+                                           * Files that are opened in an editor are always parsed by
+                                           * the code model. */
+  bool useCodeModelSnapshot;              /*!< Use the documents that the code model already parsed
+                                           * instead of asking it to parse the files again. Only
+                                           * files that are not in the snapshot of the code model,
+                                           * or that changed since they were parsed, are parsed
+                                           * again. The code model releases the source of the
+                                           * documents that it indexed, if lexClosedFiles is set
+                                           * such files are lexed from disk using the identifiers
+                                           * of the document, otherwise they are parsed again. */
 
   void loadFromSettings(Utils::QtcSettings* settings);
   void saveToSetting(Utils::QtcSettings* settings) const;
@@ -0,0 +1,134 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cpplineoffsettable.h"
+#include "cppsourcelexer.h"
+
+#include <cplusplus/Lexer.h>
+
+#include <QSet>
+
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+namespace {
+/*! \brief Get the number of UTF-16 characters of the UTF-8 \a bytes.
+ *
+ * All bytes, except for continuation bytes, start a character. Characters
+ * of 4 bytes need a surrogate pair. */
+int32_t utf16Length( QByteArrayView bytes )
+{
+  int32_t length = 0;
+  for( const char byte: bytes ) {
+    const uchar value = uchar( byte );
+    if( ( value & 0xC0 ) != 0x80 ) {
+      ++length;
+    }
+    if( value >= 0xF0 ) {
+      ++length;
+    }
+  }
+  return length;
+}
+// --------------------------------------------------
+} // namespace
+
+CppSourceLexer::CppSourceLexer( const QString& fileName )
+  : d_file( fileName )
+{
+  if( d_file.open( QIODevice::ReadOnly ) == false ) {
+    return;
+  }
+  d_valid = true;
+  const qint64 size = d_file.size();
+  if( size == 0 ) {
+    return;
+  }
+  /* Map the file so that it is not copied into memory. Some file systems do
+   * not support mapping, then the file is read. */
+  const uchar* const mapped = d_file.map( 0, size );
+  if( mapped != nullptr ) {
+    d_source = QByteArrayView( reinterpret_cast<const char*>( mapped ), qsizetype( size ) );
+  } else {
+    d_contents = d_file.readAll();
+    d_source   = d_contents;
+  }
+}
+// --------------------------------------------------
+
+void CppSourceLexer::lex( QVector<Token>& tokens, QStringList* identifiers ) const
+{
+  if( d_source.isEmpty() == true ) {
+    return;
+  }
+  const CppLineOffsetTable lineOffsets( d_source );
+  QSet<QByteArrayView> identifierBytes;
+
+  CPlusPlus::Lexer lexer( d_source.data(), d_source.data() + d_source.size() );
+  lexer.setLanguageFeatures( CPlusPlus::LanguageFeatures::defaultFeatures() );
+  lexer.setScanCommentTokens( true );
+
+  /* If the current line is a preprocessor directive. */
+  bool inDirective = false;
+  CPlusPlus::Token token;
+  while( true ) {
+    lexer.scan( &token );
+    if( token.is( CPlusPlus::T_EOF_SYMBOL ) == true ) {
+      break;
+    }
+    if( token.newline() == true ) {
+      /* A directive ends at the end of its line, the lexer joins lines that
+       * end with a backslash. */
+      inDirective = token.is( CPlusPlus::T_POUND );
+    }
+
+    if( token.is( CPlusPlus::T_IDENTIFIER ) == true ) {
+      if( identifiers != nullptr ) {
+        identifierBytes.insert( d_source.sliced( token.bytesBegin(), token.bytes() ) );
+      }
+      continue;
+    }
+    if( ( token.isComment() == false )
+        && ( ( token.isStringLiteral() == false ) || ( inDirective == true ) ) ) {
+      /* Only comments and string literals outside of directives are
+       * returned. */
+      continue;
+    }
+    Token found;
+    found.kind       = token.kind();
+    found.bytesBegin = token.bytesBegin();
+    found.bytes      = token.bytes();
+    /* The columns are counted in UTF-16 characters, the same as the code
+     * model does. */
+    const int32_t line        = lineOffsets.lineAt( found.bytesBegin );
+    const qsizetype lineStart = lineOffsets.lineStart( line );
+    found.line                = line + 1;
+    found.column              = utf16Length( d_source.sliced( lineStart, found.bytesBegin - lineStart ) ) + 1;
+    tokens.append( found );
+  }
+
+  if( identifiers != nullptr ) {
+    identifiers->clear();
+    identifiers->reserve( identifierBytes.size() );
+    for( const QByteArrayView identifier: std::as_const( identifierBytes ) ) {
+      identifiers->append( QString::fromUtf8( identifier ) );
+    }
+  }
+}
+// --------------------------------------------------
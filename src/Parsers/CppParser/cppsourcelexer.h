@@ -0,0 +1,95 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <cplusplus/Token.h>
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief The C++ Source Lexer class.
+ *
+ * Lightweight alternative to the code model for files that are not open in
+ * an editor. The file is mapped into memory and lexed with the
+ * CPlusPlus::Lexer, without preprocessing or parsing it. Only the comments,
+ * the string literals and the identifiers are taken from the tokens.
+ *
+ * Since the source is not preprocessed, the string literals that are
+ * arguments of macros are found as normal string literals. String literals
+ * inside of preprocessor directives, like the file name of an include or
+ * the value of a define, are skipped since the code model also does not see
+ * them as literals. Code that is disabled by the preprocessor is lexed as
+ * any other code. */
+class CppSourceLexer
+{
+public:
+  /*! \brief Comment or string literal found in the source. */
+  struct Token
+  {
+    CPlusPlus::Kind kind = CPlusPlus::T_EOF_SYMBOL;
+    qsizetype bytesBegin = 0; /*!< Offset of the token in the UTF-8 source. */
+    qsizetype bytes      = 0; /*!< Length of the token in UTF-8 bytes. */
+    int32_t line         = 0; /*!< Line of the token, starting at 1. */
+    int32_t column       = 0; /*!< Column of the token in UTF-16 characters, starting at 1. */
+
+    /*! \brief Check if the token is a string literal, otherwise it is a comment. */
+    bool isStringLiteral() const
+    {
+      return ( kind >= CPlusPlus::T_FIRST_STRING_LITERAL ) && ( kind <= CPlusPlus::T_LAST_STRING_LITERAL );
+    }
+  };
+
+  /*! \brief Constructor
+   *
+   * Map the file into memory.
+   * \param[in] fileName File that must be lexed. */
+  explicit CppSourceLexer( const QString& fileName );
+  CppSourceLexer( const CppSourceLexer& )            = delete;
+  CppSourceLexer& operator=( const CppSourceLexer& ) = delete;
+
+  /*! \brief Check if the file could be read. */
+  bool isValid() const { return d_valid; }
+  /*! \brief Get the UTF-8 source of the file. The source stays valid for as
+   * long as the lexer. */
+  QByteArrayView source() const { return d_source; }
+  /*! \brief Lex the source.
+   * \param[out] tokens Comments and string literals of the source, in the
+   *              order that they appear in the source.
+   * \param[out] identifiers If not nullptr, the identifiers that appear in the
+   *              source are set on this list, each one once. */
+  void lex( QVector<Token>& tokens, QStringList* identifiers ) const;
+
+private:
+  QFile d_file;
+  QByteArray d_contents;   /*!< Contents of the file if it could not be mapped. */
+  QByteArrayView d_source;
+  bool d_valid = false;
+};
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
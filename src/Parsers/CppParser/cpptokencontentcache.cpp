@@ -0,0 +1,118 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cpptokencontentcache.h"
+
+using namespace SpellChecker;
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+CppTokenContentCache::CppTokenContentCache( std::size_t maximumSize )
+  : d_shards()
+  , d_shardMaximumSize( maximumSize / SHARD_COUNT )
+{}
+// --------------------------------------------------
+
+CppTokenContentCache::RelativeWordsPtr CppTokenContentCache::find( const Key& key )
+{
+  Shard& shard = shardFor( key );
+  QMutexLocker locker( &shard.mutex );
+  const auto iter = shard.entries.find( key );
+  if( iter == shard.entries.end() ) {
+    return nullptr;
+  }
+  shard.recentlyUsed.splice( shard.recentlyUsed.begin(), shard.recentlyUsed, iter->recentlyUsed );
+  return iter->words;
+}
+// --------------------------------------------------
+
+void CppTokenContentCache::insert( const Key& key, WordList&& words )
+{
+  /* The list is shared with the processors of other files on other threads,
+   * thus it must be finalized first. The positions relative to the token are
+   * in the same order as in the file. */
+  words.finalize();
+  /* Only the larger parts are counted, the estimate does not need to be exact. */
+  std::size_t size = sizeof( Entry ) + sizeof( Key );
+  for( const Word& word: words ) {
+    size += sizeof( Word ) + sizeof( int32_t ) + std::size_t( word.text.capacity() ) * sizeof( QChar );
+  }
+  const RelativeWordsPtr shared = std::make_shared<const WordList>( std::move( words ) );
+
+  Shard& shard = shardFor( key );
+  QMutexLocker locker( &shard.mutex );
+  if( shard.entries.contains( key ) == true ) {
+    /* Another file added the same token in the meantime. */
+    return;
+  }
+  shard.recentlyUsed.push_front( key );
+  shard.entries.insert( key, Entry{ shared, size, shard.recentlyUsed.begin() } );
+  shard.size += size;
+  /* Evict the least recently used tokens, but always keep the new one. */
+  while( ( shard.size > d_shardMaximumSize ) && ( shard.entries.size() > 1 ) ) {
+    const auto iter = shard.entries.find( shard.recentlyUsed.back() );
+    shard.size -= iter->size;
+    shard.entries.erase( iter );
+    shard.recentlyUsed.pop_back();
+  }
+}
+// --------------------------------------------------
+
+void CppTokenContentCache::clear()
+{
+  for( Shard& shard: d_shards ) {
+    QMutexLocker locker( &shard.mutex );
+    shard.entries.clear();
+    shard.recentlyUsed.clear();
+    shard.size = 0;
+  }
+}
+// --------------------------------------------------
+
+WordList CppTokenContentCache::toRelative( const WordList& words, int32_t tokenLine, int32_t tokenColumn )
+{
+  WordList relative;
+  relative.reserve( words.size() );
+  for( Word word: words ) {
+    if( word.lineNumber == tokenLine ) {
+      word.columnNumber -= tokenColumn;
+    }
+    word.lineNumber -= tokenLine;
+    word.fileName.clear();
+    relative.append( std::move( word ) );
+  }
+  return relative;
+}
+// --------------------------------------------------
+
+WordList CppTokenContentCache::fromRelative( const WordList& words, int32_t tokenLine, int32_t tokenColumn, const QString& fileName )
+{
+  WordList absolute;
+  absolute.reserve( words.size() );
+  for( Word word: words ) {
+    if( word.lineNumber == 0 ) {
+      word.columnNumber += tokenColumn;
+    }
+    word.lineNumber += tokenLine;
+    word.fileName    = fileName;
+    absolute.append( std::move( word ) );
+  }
+  return absolute;
+}
+// --------------------------------------------------
@@ -0,0 +1,139 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "../../Word.h"
+
+#include <QHash>
+#include <QMutex>
+
+#include <array>
+#include <list>
+#include <memory>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief The C++ Token Content Cache class.
+ *
+ * Cache of the words of tokens (comments and literals) by the content of the
+ * token, shared by all files. The same license headers, Doxygen boilerplate
+ * and string literals appear in many files, the words of such a token are
+ * only extracted and filtered once and are then reused by every file that
+ * contains the same token.
+ *
+ * A token is identified by a strong 64-bit hash of its text, see
+ * tokenHash64(), and the length of the text. The hash must be seeded with
+ * everything else that changes the words of the token, like the type of the
+ * token and the fingerprint of the settings that were applied.
+ *
+ * The words are stored before the identifiers are removed, see
+ * CppWordFilterPlan::removeIdentifiers(), thus they do not depend on the
+ * identifiers of the file that added them or on the state of the index.
+ *
+ * The words are stored relative to the start of the token, see
+ * toRelative() and fromRelative(), so that a token can be reused after only
+ * fixing up the positions of the words.
+ *
+ * The cache is split up in shards by the hash, each with its own lock and
+ * its own least recently used list, so that the processors running on
+ * different threads rarely wait for each other. The size of each shard is
+ * limited to its part of the maximum size of the cache. */
+class CppTokenContentCache
+{
+public:
+  /*! \brief Key of a token in the cache. */
+  struct Key
+  {
+    uint64_t hash    = 0;
+    qsizetype length = 0;
+
+    bool operator==( const Key& other ) const { return ( hash == other.hash ) && ( length == other.length ); }
+  };
+  /*! \brief Words of a token, relative to the start of the token. */
+  using RelativeWordsPtr = std::shared_ptr<const WordList>;
+
+  /*! \brief Constructor
+   * \param[in] maximumSize Maximum estimated size of the cache in bytes. */
+  explicit CppTokenContentCache( std::size_t maximumSize );
+  CppTokenContentCache( const CppTokenContentCache& )            = delete;
+  CppTokenContentCache& operator=( const CppTokenContentCache& ) = delete;
+
+  /*! \brief Get the relative words of the token with the \a key.
+   * \return The words, or nullptr if the token is not in the cache. */
+  RelativeWordsPtr find( const Key& key );
+  /*! \brief Add the relative \a words of the token with the \a key.
+   *
+   * The words are finalized before they are shared. */
+  void insert( const Key& key, WordList&& words );
+  /*! \brief Remove all of the tokens from the cache. */
+  void clear();
+
+  /*! \brief Make the \a words of a token relative to the start of the token.
+   *
+   * The line numbers become the number of lines after the line of the token.
+   * Only the columns of the words on the first line of the token depend on
+   * the column of the token, they become the number of columns after the
+   * column of the token. The file name of the words is removed. */
+  static WordList toRelative( const WordList& words, int32_t tokenLine, int32_t tokenColumn );
+  /*! \brief Get the words of a token at the \a tokenLine and \a tokenColumn
+   * in the \a fileName from the relative \a words, see toRelative(). */
+  static WordList fromRelative( const WordList& words, int32_t tokenLine, int32_t tokenColumn, const QString& fileName );
+
+private:
+  /*! \brief Entry of a single token. */
+  struct Entry
+  {
+    RelativeWordsPtr words;
+    std::size_t size = 0;
+    std::list<Key>::iterator recentlyUsed;
+  };
+  /*! \brief Part of the cache with its own lock. */
+  struct Shard
+  {
+    QMutex mutex;
+    QHash<Key, Entry> entries;
+    std::list<Key> recentlyUsed; /*!< Tokens, the most recently used first. */
+    std::size_t size = 0;
+  };
+  /*! \brief Number of shards. The high bits of the hash select the shard,
+   * the low bits are used by the hash of the shard. */
+  static constexpr std::size_t SHARD_COUNT = 16;
+
+  Shard& shardFor( const Key& key ) { return d_shards[( key.hash >> 32 ) % SHARD_COUNT]; }
+
+  std::array<Shard, SHARD_COUNT> d_shards;
+  const std::size_t d_shardMaximumSize;
+};
+
+/*! \brief Hash of the key of a token, the key is already a hash. */
+inline size_t qHash( const CppTokenContentCache::Key& key, size_t seed = 0 )
+{
+  return size_t( key.hash ) ^ seed;
+}
+
+/*! \brief Shared token content cache. */
+using CppTokenContentCachePtr = std::shared_ptr<CppTokenContentCache>;
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
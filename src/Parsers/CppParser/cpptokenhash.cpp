@@ -0,0 +1,129 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cpptokenhash.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+/* Primes of XXH64. */
+constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+/* Number of bytes that are consumed by each of the stripes of the main loop. */
+constexpr qsizetype STRIPE_SIZE = 32;
+
+inline uint64_t rotateLeft( uint64_t value, int bits )
+{
+  return ( value << bits ) | ( value >> ( 64 - bits ) );
+}
+// --------------------------------------------------
+
+inline uint64_t read64( const char* data )
+{
+  uint64_t value;
+  std::memcpy( &value, data, sizeof( value ) );
+  return qFromLittleEndian( value );
+}
+// --------------------------------------------------
+
+inline uint32_t read32( const char* data )
+{
+  uint32_t value;
+  std::memcpy( &value, data, sizeof( value ) );
+  return qFromLittleEndian( value );
+}
+// --------------------------------------------------
+
+inline uint64_t accumulate( uint64_t accumulator, uint64_t input )
+{
+  accumulator += input * PRIME2;
+  accumulator  = rotateLeft( accumulator, 31 );
+  return accumulator * PRIME1;
+}
+// --------------------------------------------------
+
+inline uint64_t mergeRound( uint64_t accumulator, uint64_t value )
+{
+  accumulator ^= accumulate( 0, value );
+  return accumulator * PRIME1 + PRIME4;
+}
+// --------------------------------------------------
+} // namespace
+
+uint64_t SpellChecker::CppSpellChecker::Internal::tokenHash64( QByteArrayView data, uint64_t seed )
+{
+  const char* pos       = data.data();
+  const char* const end = pos + data.size();
+  uint64_t hash;
+
+  if( data.size() >= STRIPE_SIZE ) {
+    /* Four independent lanes, each consuming 8 bytes of a stripe. */
+    uint64_t v1 = seed + PRIME1 + PRIME2;
+    uint64_t v2 = seed + PRIME2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME1;
+    const char* const limit = end - STRIPE_SIZE;
+    do {
+      v1   = accumulate( v1, read64( pos ) );
+      v2   = accumulate( v2, read64( pos + 8 ) );
+      v3   = accumulate( v3, read64( pos + 16 ) );
+      v4   = accumulate( v4, read64( pos + 24 ) );
+      pos += STRIPE_SIZE;
+    } while( pos <= limit );
+
+    hash = rotateLeft( v1, 1 ) + rotateLeft( v2, 7 ) + rotateLeft( v3, 12 ) + rotateLeft( v4, 18 );
+    hash = mergeRound( hash, v1 );
+    hash = mergeRound( hash, v2 );
+    hash = mergeRound( hash, v3 );
+    hash = mergeRound( hash, v4 );
+  } else {
+    hash = seed + PRIME5;
+  }
+  hash += uint64_t( data.size() );
+
+  /* The tail that is not a full stripe. */
+  for( ; ( end - pos ) >= 8; pos += 8 ) {
+    hash ^= accumulate( 0, read64( pos ) );
+    hash  = rotateLeft( hash, 27 ) * PRIME1 + PRIME4;
+  }
+  if( ( end - pos ) >= 4 ) {
+    hash ^= uint64_t( read32( pos ) ) * PRIME1;
+    hash  = rotateLeft( hash, 23 ) * PRIME2 + PRIME3;
+    pos  += 4;
+  }
+  for( ; pos < end; ++pos ) {
+    hash ^= uint64_t( uint8_t( *pos ) ) * PRIME5;
+    hash  = rotateLeft( hash, 11 ) * PRIME1;
+  }
+
+  /* Final avalanche so that all of the input bits affect all of the hash bits. */
+  hash ^= hash >> 33;
+  hash *= PRIME2;
+  hash ^= hash >> 29;
+  hash *= PRIME3;
+  hash ^= hash >> 32;
+  return hash;
+}
+// --------------------------------------------------
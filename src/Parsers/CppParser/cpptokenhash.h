@@ -0,0 +1,59 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QStringView>
+
+#include <cstdint>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief Strong 64-bit hash of the \a data.
+ *
+ * The hash is the XXH64 hash of the bytes. It is much stronger than the
+ * 32-bit qHash() and is used where a collision would attach the words of
+ * one token to another token, for example to share the words of identical
+ * tokens between files.
+ * \param[in] data Bytes to hash.
+ * \param[in] seed Seed of the hash. Different seeds give unrelated hashes
+ *              for the same data. */
+uint64_t tokenHash64( QByteArrayView data, uint64_t seed = 0 );
+/*! \brief Strong 64-bit hash of the UTF-16 \a string, see tokenHash64(). */
+inline uint64_t tokenHash64( QStringView string, uint64_t seed = 0 )
+{
+  return tokenHash64( QByteArrayView( reinterpret_cast<const char*>( string.data() ), string.size() * qsizetype( sizeof( QChar ) ) ), seed );
+}
+
+/*! \brief Combine a hash from tokenHash64() with a \a seed.
+ *
+ * The result is the same as a hash of the data with a seed that depends on
+ * the \a seed, without hashing the data again. */
+inline uint64_t tokenHash64Seeded( uint64_t hash, uint64_t seed )
+{
+  return tokenHash64( QByteArrayView( reinterpret_cast<const char*>( &hash ), qsizetype( sizeof( hash ) ) ), seed );
+}
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
@@ -0,0 +1,142 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cpptokenhashcache.h"
+
+using namespace SpellChecker;
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+CppTokenHashCache::CppTokenHashCache( std::size_t maximumSize )
+  : d_maximumSize( maximumSize )
+{}
+// --------------------------------------------------
+
+HashWordsPtr CppTokenHashCache::find( const QString& fileName )
+{
+  QMutexLocker locker( &d_mutex );
+  const auto iter = d_entries.find( fileName );
+  if( iter == d_entries.end() ) {
+    ++d_misses;
+    return nullptr;
+  }
+  ++d_hits;
+  /* Move the file to the front of the recently used files. */
+  d_recentlyUsed.splice( d_recentlyUsed.begin(), d_recentlyUsed, iter->recentlyUsed );
+  return iter->hashes;
+}
+// --------------------------------------------------
+
+void CppTokenHashCache::insert( const QString& fileName, HashWords&& hashes )
+{
+  /* The size is estimated and the snapshot is created before the lock is
+   * taken. */
+  const std::size_t size    = estimatedSize( hashes );
+  const HashWordsPtr shared = std::make_shared<const HashWords>( std::move( hashes ) );
+
+  QMutexLocker locker( &d_mutex );
+  auto iter = d_entries.find( fileName );
+  if( iter == d_entries.end() ) {
+    d_recentlyUsed.push_front( fileName );
+    iter               = d_entries.insert( fileName, Entry() );
+    iter->recentlyUsed = d_recentlyUsed.begin();
+  } else {
+    d_size -= iter->size;
+    d_recentlyUsed.splice( d_recentlyUsed.begin(), d_recentlyUsed, iter->recentlyUsed );
+  }
+  iter->hashes = shared;
+  iter->size   = size;
+  d_size      += size;
+  evict();
+}
+// --------------------------------------------------
+
+void CppTokenHashCache::remove( const QStringSet& fileNames )
+{
+  QMutexLocker locker( &d_mutex );
+  for( const QString& fileName: fileNames ) {
+    const auto iter = d_entries.find( fileName );
+    if( iter != d_entries.end() ) {
+      removeEntry( iter );
+    }
+  }
+}
+// --------------------------------------------------
+
+void CppTokenHashCache::clear()
+{
+  QMutexLocker locker( &d_mutex );
+  d_entries.clear();
+  d_recentlyUsed.clear();
+  d_size = 0;
+}
+// --------------------------------------------------
+
+void CppTokenHashCache::setMaximumSize( std::size_t maximumSize )
+{
+  QMutexLocker locker( &d_mutex );
+  d_maximumSize = maximumSize;
+  evict();
+}
+// --------------------------------------------------
+
+CppTokenHashCache::Statistics CppTokenHashCache::statistics() const
+{
+  QMutexLocker locker( &d_mutex );
+  Statistics stats;
+  stats.hits   = d_hits;
+  stats.misses = d_misses;
+  stats.files  = d_entries.size();
+  stats.size   = d_size;
+  return stats;
+}
+// --------------------------------------------------
+
+std::size_t CppTokenHashCache::estimatedSize( const HashWords& hashes )
+{
+  /* Only the larger parts are counted, the estimate does not need to be exact.
+   * The file names of the words are shared and are not counted. */
+  std::size_t size = std::size_t( hashes.capacity() ) * ( sizeof( HashWords::key_type ) + sizeof( TokenWords ) );
+  for( const TokenWords& token: hashes ) {
+    for( const Word& word: token.words ) {
+      size += sizeof( Word ) + std::size_t( word.text.capacity() ) * sizeof( QChar );
+    }
+  }
+  return size;
+}
+// --------------------------------------------------
+
+void CppTokenHashCache::removeEntry( QHash<QString, Entry>::iterator iter )
+{
+  /* The lock must be held by the caller. */
+  d_size -= iter->size;
+  d_recentlyUsed.erase( iter->recentlyUsed );
+  d_entries.erase( iter );
+}
+// --------------------------------------------------
+
+void CppTokenHashCache::evict()
+{
+  /* The lock must be held by the caller. The most recently used file is always
+   * kept, even if it is larger than the maximum size on its own. */
+  while( ( d_size > d_maximumSize ) && ( d_entries.size() > 1 ) ) {
+    removeEntry( d_entries.find( d_recentlyUsed.back() ) );
+  }
+}
+// --------------------------------------------------
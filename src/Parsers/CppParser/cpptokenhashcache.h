@@ -0,0 +1,120 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "../../Word.h"
+
+#include <QHash>
+#include <QMutex>
+
+#include <list>
+#include <memory>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief Shared, immutable snapshot of the token hashes of a file. */
+using HashWordsPtr = std::shared_ptr<const HashWords>;
+
+/*! \brief The C++ Token Hash Cache class.
+ *
+ * Cache of the token hashes (see HashWords) of the files that were parsed
+ * most recently. If a file is parsed again, the words of the tokens that did
+ * not change are reused from the cache, for any file and not only for the
+ * current editor.
+ *
+ * The cache holds an immutable snapshot of the hashes of each file. A
+ * processor gets the snapshot of its file and uses it without any locking.
+ * When the processor is done, the new hashes replace the snapshot of the
+ * file. The lock of the cache is only held to look up or replace a
+ * snapshot.
+ *
+ * The size of the cache is limited to an estimated maximum size in bytes.
+ * The least recently used files are removed from the cache when it grows
+ * beyond the maximum size. */
+class CppTokenHashCache
+{
+public:
+  /*! \brief Statistics of the cache. */
+  struct Statistics
+  {
+    uint64_t hits    = 0; /*!< Number of lookups that found the file. */
+    uint64_t misses  = 0; /*!< Number of lookups that did not find the file. */
+    qsizetype files  = 0; /*!< Number of files in the cache. */
+    std::size_t size = 0; /*!< Estimated size of the cache in bytes. */
+
+    /*! \brief Ratio of the lookups that found the file, between 0 and 1. */
+    double hitRate() const
+    {
+      const uint64_t lookups = hits + misses;
+      return ( lookups == 0 ) ? 0.0 : double( hits ) / double( lookups );
+    }
+  };
+
+  /*! \brief Constructor
+   * \param[in] maximumSize Maximum estimated size of the cache in bytes. */
+  explicit CppTokenHashCache( std::size_t maximumSize );
+  CppTokenHashCache( const CppTokenHashCache& )            = delete;
+  CppTokenHashCache& operator=( const CppTokenHashCache& ) = delete;
+
+  /*! \brief Get the snapshot of the hashes of the file.
+   * \return The hashes of the file, or nullptr if the file is not in the
+   *          cache. */
+  HashWordsPtr find( const QString& fileName );
+  /*! \brief Replace the hashes of the file with the new \a hashes. */
+  void insert( const QString& fileName, HashWords&& hashes );
+  /*! \brief Remove the hashes of the files. */
+  void remove( const QStringSet& fileNames );
+  /*! \brief Remove all of the hashes from the cache. */
+  void clear();
+  /*! \brief Set the maximum estimated size of the cache in bytes. */
+  void setMaximumSize( std::size_t maximumSize );
+  /*! \brief Get the statistics of the cache. */
+  Statistics statistics() const;
+
+  /*! \brief Estimate the number of bytes used by the \a hashes. */
+  static std::size_t estimatedSize( const HashWords& hashes );
+
+private:
+  /*! \brief Entry of a single file. */
+  struct Entry
+  {
+    HashWordsPtr hashes;
+    std::size_t size = 0;
+    std::list<QString>::iterator recentlyUsed;
+  };
+
+  void removeEntry( QHash<QString, Entry>::iterator iter );
+  void evict();
+
+  mutable QMutex d_mutex;
+  QHash<QString, Entry> d_entries;
+  std::list<QString> d_recentlyUsed; /*!< Files, the most recently used first. */
+  std::size_t d_size        = 0;
+  std::size_t d_maximumSize = 0;
+  uint64_t d_hits           = 0;
+  uint64_t d_misses         = 0;
+};
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
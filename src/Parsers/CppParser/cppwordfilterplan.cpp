@@ -0,0 +1,518 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "../../idocumentparser.h"
+#include "cppidentifierindex.h"
+#include "cppwordfilterplan.h"
+
+#include <cppeditor/cpptoolsreuse.h>
+
+#include <QVarLengthArray>
+
+#include <algorithm>
+
+using namespace SpellChecker;
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+namespace {
+
+bool isAsciiLower( QChar character )
+{
+  return ( character >= QLatin1Char( 'a' ) ) && ( character <= QLatin1Char( 'z' ) );
+}
+// --------------------------------------------------
+
+bool isAsciiUpper( QChar character )
+{
+  return ( character >= QLatin1Char( 'A' ) ) && ( character <= QLatin1Char( 'Z' ) );
+}
+// --------------------------------------------------
+
+bool isAsciiDigit( QChar character )
+{
+  return ( character >= QLatin1Char( '0' ) ) && ( character <= QLatin1Char( '9' ) );
+}
+// --------------------------------------------------
+
+bool isHexDigit( QChar character )
+{
+  return ( isAsciiDigit( character ) == true )
+         || ( ( character >= QLatin1Char( 'a' ) ) && ( character <= QLatin1Char( 'f' ) ) )
+         || ( ( character >= QLatin1Char( 'A' ) ) && ( character <= QLatin1Char( 'F' ) ) );
+}
+// --------------------------------------------------
+
+/*! \brief Word character, the same as \w in a regular expression. */
+bool isWordChar( QChar character )
+{
+  return ( character.isLetterOrNumber() == true ) || ( character == QLatin1Char( '_' ) );
+}
+// --------------------------------------------------
+
+/*! \brief Characters that can be part of a website address, the same as
+ * Constants::WEBSITE_CHARS_REGEXP_PATTERN. */
+bool isWebsiteChar( QChar character )
+{
+  switch( character.unicode() ) {
+    case '/':
+    case ':':
+    case '?':
+    case '=':
+    case '#':
+    case '%':
+    case '-':
+      return true;
+    default:
+      return false;
+  }
+}
+// --------------------------------------------------
+
+/*! \brief Characters that can follow the domain of a website address, the
+ * same as the last part of Constants::WEBSITE_ADDRESS_REGEXP_PATTERN. */
+bool isWebsiteAddressChar( QChar character )
+{
+  /* Note that the range A-z includes the characters between 'Z' and 'a'. */
+  return ( isAsciiDigit( character ) == true )
+         || ( ( character >= QLatin1Char( 'A' ) ) && ( character <= QLatin1Char( 'z' ) ) )
+         || ( character == QLatin1Char( '.' ) )
+         || ( character == QLatin1Char( '/' ) )
+         || ( character == QLatin1Char( '?' ) )
+         || ( character == QLatin1Char( '=' ) )
+         || ( character == QLatin1Char( '#' ) )
+         || ( character == QLatin1Char( '%' ) )
+         || ( character == QLatin1Char( '-' ) );
+}
+// --------------------------------------------------
+
+/*! \brief Check if the word is a Qt keyword, as is or in all caps.
+ *
+ * The all caps version of the word is made in a buffer on the stack. Words
+ * that are longer than the buffer are longer than any Qt keyword. */
+bool isQtKeywordInAnyCase( QStringView word )
+{
+  if( CppEditor::isQtKeyword( word ) == true ) {
+    return true;
+  }
+  constexpr qsizetype MAX_KEYWORD_LENGTH = 32;
+  if( word.size() > MAX_KEYWORD_LENGTH ) {
+    return false;
+  }
+  QVarLengthArray<QChar, MAX_KEYWORD_LENGTH> caps;
+  for( const QChar character: word ) {
+    caps.append( character.toUpper() );
+  }
+  return CppEditor::isQtKeyword( QStringView( caps.constData(), caps.size() ) );
+}
+// --------------------------------------------------
+
+/*! \brief Split the \a word on the characters for which \a isSeparator is true.
+ *
+ * The parts that are not empty are added to the \a fragments.
+ * \return True if any parts were added. */
+template<typename Predicate>
+bool splitWord( const WordView& word, Predicate isSeparator, WordViewList& fragments )
+{
+  const std::size_t fragmentsBefore = fragments.size();
+  const qsizetype length            = word.text.size();
+  qsizetype partStart               = 0;
+  for( qsizetype idx = 0; idx <= length; ++idx ) {
+    if( ( idx == length ) || ( isSeparator( word.text[idx] ) == true ) ) {
+      if( idx > partStart ) {
+        fragments.push_back( IDocumentParser::subWordView( word, partStart, idx - partStart ) );
+      }
+      partStart = idx + 1;
+    }
+  }
+  return fragments.size() != fragmentsBefore;
+}
+// --------------------------------------------------
+
+} // namespace
+
+/*! \brief Classification of a word, made in a single scan of the word.
+ *
+ * Each member replaces one of the regular expressions that were used to
+ * check the words against the settings. */
+class CppWordFilterPlan::WordTraits
+{
+public:
+  explicit WordTraits( QStringView word );
+
+  bool isNumber          = false; /*!< \A\d+(\.\d+)?\z */
+  bool isHexNumber       = false; /*!< \A0x[0-9A-Fa-f]+\z */
+  bool isColor           = false; /*!< \A([0-9A-Fa-f]{2}){3,4}\z */
+  bool isEmailAddress    = false; /*!< Constants::EMAIL_ADDRESS_REGEXP_PATTERN */
+  bool hasWebsiteAddress = false; /*!< Constants::WEBSITE_ADDRESS_REGEXP_PATTERN */
+  bool hasWebsiteChar    = false; /*!< Constants::WEBSITE_CHARS_REGEXP_PATTERN */
+  bool hasLowerCase      = false;
+  bool hasAsciiDigit     = false; /*!< [0-9] */
+  bool hasUnderscore     = false;
+  bool hasDot            = false;
+  bool hasCamelCase      = false; /*!< [a-z]{1,}[A-Z]{1,}[a-z]{1,} */
+};
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+CppWordFilterPlan::WordTraits::WordTraits( QStringView word )
+{
+  enum class NumberState { Start, Integer, Dot, Fraction, Invalid };
+  enum class CamelCaseState { None, Lower, LowerUpper };
+  NumberState numberState       = NumberState::Start;
+  CamelCaseState camelCaseState = CamelCaseState::None;
+  const qsizetype length        = word.size();
+  bool allHexDigits             = true;
+  bool hexAfterPrefix           = ( length > 2 ) && ( word[0] == QLatin1Char( '0' ) ) && ( word[1] == QLatin1Char( 'x' ) );
+  /* Email address: local part, '@', domain labels ending in a dot and a top
+   * level domain of 2 to 4 ASCII letters. */
+  qsizetype atCount     = 0;
+  qsizetype atPosition  = -1;
+  qsizetype lastDot     = -1;
+  bool validLocalPart   = true;
+  bool validDomain      = true;
+
+  for( qsizetype idx = 0; idx < length; ++idx ) {
+    const QChar character = word[idx];
+    const bool digit      = character.isDigit();
+
+    switch( numberState ) {
+      case NumberState::Start:
+      case NumberState::Dot:
+        numberState = ( digit == true )
+                      ? ( ( numberState == NumberState::Start ) ? NumberState::Integer : NumberState::Fraction )
+                      : NumberState::Invalid;
+        break;
+      case NumberState::Integer:
+        if( digit == false ) {
+          numberState = ( character == QLatin1Char( '.' ) ) ? NumberState::Dot : NumberState::Invalid;
+        }
+        break;
+      case NumberState::Fraction:
+        if( digit == false ) {
+          numberState = NumberState::Invalid;
+        }
+        break;
+      case NumberState::Invalid:
+        break;
+    }
+
+    const bool hexDigit = isHexDigit( character );
+    allHexDigits = allHexDigits && hexDigit;
+    if( idx >= 2 ) {
+      hexAfterPrefix = hexAfterPrefix && hexDigit;
+    }
+
+    if( character.isLower() == true ) {
+      hasLowerCase = true;
+    }
+    if( isAsciiDigit( character ) == true ) {
+      hasAsciiDigit = true;
+    }
+    if( character == QLatin1Char( '_' ) ) {
+      hasUnderscore = true;
+    }
+    if( isWebsiteChar( character ) == true ) {
+      hasWebsiteChar = true;
+    }
+
+    if( character == QLatin1Char( '.' ) ) {
+      hasDot = true;
+      /* A word character, a dot and a website address character is the
+       * shortest website address. */
+      if( ( idx > 0 ) && ( idx + 1 < length )
+          && ( isWordChar( word[idx - 1] ) == true )
+          && ( isWebsiteAddressChar( word[idx + 1] ) == true ) ) {
+        hasWebsiteAddress = true;
+      }
+    }
+
+    if( isAsciiLower( character ) == true ) {
+      if( camelCaseState == CamelCaseState::LowerUpper ) {
+        hasCamelCase = true;
+      }
+      camelCaseState = CamelCaseState::Lower;
+    } else if( isAsciiUpper( character ) == true ) {
+      camelCaseState = ( camelCaseState == CamelCaseState::None ) ? CamelCaseState::None : CamelCaseState::LowerUpper;
+    } else {
+      camelCaseState = CamelCaseState::None;
+    }
+
+    if( character == QLatin1Char( '@' ) ) {
+      ++atCount;
+      atPosition = idx;
+    } else if( atCount == 0 ) {
+      validLocalPart = validLocalPart
+                       && ( ( isWordChar( character ) == true )
+                            || ( character == QLatin1Char( '-' ) )
+                            || ( character == QLatin1Char( '.' ) ) );
+    } else if( character == QLatin1Char( '.' ) ) {
+      /* Labels of the domain can not be empty. */
+      const QChar previous = word[idx - 1];
+      validDomain = validDomain && ( previous != QLatin1Char( '@' ) ) && ( previous != QLatin1Char( '.' ) );
+      lastDot     = idx;
+    } else {
+      validDomain = validDomain && ( isWordChar( character ) == true );
+    }
+  }
+
+  isNumber    = ( numberState == NumberState::Integer ) || ( numberState == NumberState::Fraction );
+  isHexNumber = hexAfterPrefix;
+  isColor     = ( allHexDigits == true ) && ( ( length == 6 ) || ( length == 8 ) );
+
+  if( ( atCount == 1 ) && ( atPosition > 0 ) && ( validLocalPart == true )
+      && ( validDomain == true ) && ( lastDot > atPosition + 1 ) ) {
+    const QStringView topLevelDomain = word.sliced( lastDot + 1 );
+    isEmailAddress = ( topLevelDomain.size() >= 2 ) && ( topLevelDomain.size() <= 4 )
+                     && std::all_of( topLevelDomain.cbegin(), topLevelDomain.cend(), []( QChar character ) {
+          return ( isAsciiLower( character ) == true ) || ( isAsciiUpper( character ) == true );
+        } );
+  }
+}
+// --------------------------------------------------
+
+CppWordFilterPlan::CppWordFilterPlan( const CppParserSettings& settings )
+  : d_whatToCheck( settings.whatToCheck )
+  , d_commentsToCheck( settings.commentsToCheck )
+  , d_checkQtKeywords( settings.checkQtKeywords )
+  , d_checkAllCapsWords( settings.checkAllCapsWords )
+  , d_wordsWithNumberOption( settings.wordsWithNumberOption )
+  , d_wordsWithUnderscoresOption( settings.wordsWithUnderscoresOption )
+  , d_camelCaseWordOption( settings.camelCaseWordOption )
+  , d_removeWordsThatAppearInSource( settings.removeWordsThatAppearInSource )
+  , d_removeEmailAddresses( settings.removeEmailAddresses )
+  , d_wordsWithDotsOption( settings.wordsWithDotsOption )
+  , d_removeWebsites( settings.removeWebsites )
+  , d_removeFirstComment( settings.removeFirstComment )
+  , d_fingerprint( qHashMulti( 0,
+                               d_checkQtKeywords,
+                               d_checkAllCapsWords,
+                               int( d_wordsWithNumberOption ),
+                               int( d_wordsWithUnderscoresOption ),
+                               int( d_camelCaseWordOption ),
+                               d_removeWordsThatAppearInSource,
+                               d_removeEmailAddresses,
+                               int( d_wordsWithDotsOption ),
+                               d_removeWebsites ) )
+{}
+// --------------------------------------------------
+
+void CppWordFilterPlan::apply( WordViewList& words ) const
+{
+  /* Words that the words are split into. They are filtered after the words,
+   * taking the last one from the list each time until the list is empty. Words
+   * that are kept are added to the end of the words. */
+  WordViewList fragments( words.get_allocator() );
+  /* Words that were split, they are only kept for removeIdentifiers(). */
+  WordViewList splitWords( words.get_allocator() );
+  const auto isKept = [this, &fragments, &splitWords]( const WordView& word ) {
+    const std::size_t fragmentsBefore = fragments.size();
+    if( keepWord( word, fragments ) == true ) {
+      return true;
+    }
+    if( ( d_removeWordsThatAppearInSource == true )
+        && ( fragments.size() != fragmentsBefore ) ) {
+      splitWords.push_back( word );
+      splitWords.back().isSplit = true;
+    }
+    return false;
+  };
+  /* The words that are kept are moved to the front of the list, to the \a keep
+   * iterator, and the rest of the list is erased at the end. */
+  const WordViewList::iterator wordsEnd = words.end();
+  WordViewList::iterator keep           = words.begin();
+  for( WordViewList::iterator iter = words.begin(); iter != wordsEnd; ++iter ) {
+    if( isKept( *iter ) == true ) {
+      if( keep != iter ) {
+        *keep = *iter;
+      }
+      ++keep;
+    }
+  }
+  words.erase( keep, wordsEnd );
+
+  while( fragments.empty() == false ) {
+    const WordView fragment = fragments.back();
+    fragments.pop_back();
+    if( isKept( fragment ) == true ) {
+      words.push_back( fragment );
+    }
+  }
+  words.insert( words.end(), splitWords.begin(), splitWords.end() );
+}
+// --------------------------------------------------
+
+void CppWordFilterPlan::removeIdentifiers( const CppIdentifierIndex& identifiers, const WordList& words, WordList& keptWords ) const
+{
+  if( d_removeWordsThatAppearInSource == false ) {
+    for( const Word& word: words ) {
+      if( word.isSplit == false ) {
+        keptWords.append( word );
+      }
+    }
+    return;
+  }
+
+  /* The same word often appears many times in a row, thus the last word that
+   * was removed is compared first, which is faster than the search in the
+   * index. */
+  QStringView lastWordRemoved;
+  const auto isIdentifier = [&identifiers, &lastWordRemoved]( const Word& word ) {
+    if( word.text == lastWordRemoved ) {
+      return true;
+    }
+    if( identifiers.contains( word.text ) == true ) {
+      lastWordRemoved = word.text;
+      return true;
+    }
+    return false;
+  };
+
+  /* The parts of a word that was split are inside of the word, on the same
+   * line. The line and column are used since the words of a macro come from
+   * more than one string. */
+  struct Range
+  {
+    int32_t line;
+    int32_t firstColumn;
+    int32_t lastColumn;
+  };
+  QVarLengthArray<Range, 8> removedWords;
+  for( const Word& word: words ) {
+    if( ( word.isSplit == true )
+        && ( isIdentifier( word ) == true ) ) {
+      removedWords.append( { word.lineNumber, word.columnNumber, word.columnNumber + word.length } );
+    }
+  }
+  for( const Word& word: words ) {
+    if( word.isSplit == true ) {
+      continue;
+    }
+    const bool inRemovedWord = std::any_of( removedWords.cbegin(), removedWords.cend(), [&word]( const Range& range ) {
+      return ( word.lineNumber == range.line )
+             && ( word.columnNumber >= range.firstColumn )
+             && ( word.columnNumber + word.length <= range.lastColumn );
+    } );
+    if( ( inRemovedWord == false )
+        && ( isIdentifier( word ) == false ) ) {
+      keptWords.append( word );
+    }
+  }
+}
+// --------------------------------------------------
+
+bool CppWordFilterPlan::keepWord( const WordView& word, WordViewList& fragments ) const
+{
+  using Settings = CppParserSettings;
+  /* The text of the word is wrapped in a string without copying it, for the
+   * functions that take a string. */
+  const QString currentWord = QString::fromRawData( word.text.data(), word.text.size() );
+
+  /* Reserved words, this does not depend on the settings. */
+  if( IDocumentParser::isReservedWord( currentWord ) == true ) {
+    return false;
+  }
+
+  const WordTraits traits( word.text );
+
+  /* Numbers, hex numbers and colors that start with a #. */
+  if( ( traits.isNumber == true )
+      || ( traits.isHexNumber == true )
+      || ( ( traits.isColor == true ) && ( word.charBefore == QLatin1Char( '#' ) ) ) ) {
+    return false;
+  }
+
+  if( d_checkQtKeywords == false ) {
+    /* Qt keywords, words that start with a capital Q followed by a capital letter,
+     * words that start with Q_ and qDebug. */
+    if( isQtKeywordInAnyCase( word.text ) == true ) {
+      return false;
+    }
+    if( ( word.text.size() > 2 )
+        && ( word.text[0] == QLatin1Char( 'Q' ) )
+        && ( word.text[1].isUpper() == true ) ) {
+      return false;
+    }
+    if( ( word.text.startsWith( QLatin1String( "Q_" ) ) == true )
+        || ( word.text == QLatin1String( "qDebug" ) ) ) {
+      return false;
+    }
+  }
+
+  if( ( d_removeEmailAddresses == true ) && ( traits.isEmailAddress == true ) ) {
+    return false;
+  }
+
+  if( d_removeWebsites == true ) {
+    if( traits.hasWebsiteAddress == true ) {
+      return false;
+    }
+    /* Not a website, check each part between the website characters. */
+    if( ( traits.hasWebsiteChar == true )
+        && ( splitWord( word, isWebsiteChar, fragments ) == true ) ) {
+      return false;
+    }
+  }
+
+  if( ( d_checkAllCapsWords == false ) && ( traits.hasLowerCase == false ) ) {
+    return false;
+  }
+
+  if( ( d_wordsWithNumberOption != Settings::LeaveWordsWithNumbers ) && ( traits.hasAsciiDigit == true ) ) {
+    if( d_wordsWithNumberOption == Settings::SplitWordsOnNumbers ) {
+      splitWord( word, isAsciiDigit, fragments );
+    }
+    return false;
+  }
+
+  if( ( d_wordsWithUnderscoresOption != Settings::LeaveWordsWithUnderscores ) && ( traits.hasUnderscore == true ) ) {
+    if( d_wordsWithUnderscoresOption == Settings::SplitWordsOnUnderscores ) {
+      splitWord( word, []( QChar character ) { return character == QLatin1Char( '_' ); }, fragments );
+    }
+    return false;
+  }
+
+  if( ( d_camelCaseWordOption != Settings::LeaveWordsInCamelCase ) && ( traits.hasCamelCase == true ) ) {
+    if( d_camelCaseWordOption == Settings::SplitWordsOnCamelCase ) {
+      /* Split the word after each lower case letter that is followed by an upper
+       * case letter. */
+      const qsizetype length = word.text.size();
+      qsizetype wordStart    = 0;
+      for( qsizetype idx = 1; idx < length; ++idx ) {
+        if( ( isAsciiLower( word.text[idx - 1] ) == true ) && ( isAsciiUpper( word.text[idx] ) == true ) ) {
+          fragments.push_back( IDocumentParser::subWordView( word, wordStart, idx - wordStart ) );
+          wordStart = idx;
+        }
+      }
+      fragments.push_back( IDocumentParser::subWordView( word, wordStart, length - wordStart ) );
+    }
+    return false;
+  }
+
+  if( ( d_wordsWithDotsOption != Settings::LeaveWordsWithDots ) && ( traits.hasDot == true ) ) {
+    if( d_wordsWithDotsOption == Settings::SplitWordsOnDots ) {
+      splitWord( word, []( QChar character ) { return character == QLatin1Char( '.' ); }, fragments );
+    }
+    return false;
+  }
+
+  return true;
+}
+// --------------------------------------------------
@@ -0,0 +1,116 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "../../Word.h"
+#include "cppparsersettings.h"
+
+#include <memory>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+class CppIdentifierIndex;
+
+/*! \brief The C++ Word Filter Plan class.
+ *
+ * The filter plan applies the CppParserSettings to the words extracted from
+ * a document. The plan is created once from the settings each time they
+ * change and is immutable, thus it is shared by all of the document
+ * processors, on any thread, without copying the settings.
+ *
+ * Each word is classified in a single scan over its characters. The plan
+ * then uses that classification to decide if the word is kept, removed or
+ * split into smaller words. Words that are split are filtered again using a
+ * work list, without regular expressions or recursion.
+ *
+ * The plan is applied in two stages. The first stage, apply(), only depends
+ * on the words themselves, thus its result can be stored and reused for the
+ * same token. The second stage, removeIdentifiers(), removes the words that
+ * appear in the source. The identifiers change while the project is parsed,
+ * thus this stage is applied again each time the words are used. */
+class CppWordFilterPlan
+{
+public:
+  /*! \brief Constructor
+   * \param[in] settings Settings that the plan must apply. */
+  explicit CppWordFilterPlan( const CppParserSettings& settings );
+
+  /*! \brief Apply the settings that do not depend on the identifiers to the words.
+   *
+   * Words that are split up are added as views into the same strings as the
+   * words that they came from. If words that appear in the source must be
+   * removed, the words that were split are kept as well and marked with
+   * WordView::isSplit, for removeIdentifiers().
+   * \param[in,out] words Words that should be filtered. Words are removed from
+   *                  this list based on the settings. */
+  void apply( WordViewList& words ) const;
+  /*! \brief Remove the words that appear in the source as identifiers.
+   *
+   * If a word that was split is an identifier, all of its parts are removed
+   * as well. Words that were split are never added to the \a keptWords.
+   * \param[in] identifiers Identifiers that appear in the source.
+   * \param[in] words Words of a single token, as returned by apply().
+   * \param[in,out] keptWords The words that are kept are added to this list. */
+  void removeIdentifiers( const CppIdentifierIndex& identifiers, const WordList& words, WordList& keptWords ) const;
+
+  CppParserSettings::WhatToCheckOptions whatToCheck() const { return d_whatToCheck; }
+  CppParserSettings::CommentsToCheckOptions commentsToCheck() const { return d_commentsToCheck; }
+  bool removeWordsThatAppearInSource() const { return d_removeWordsThatAppearInSource; }
+  bool removeWebsites() const { return d_removeWebsites; }
+  bool removeFirstComment() const { return d_removeFirstComment; }
+  /*! \brief Fingerprint of the settings that change which words are kept.
+   *
+   * Plans with the same fingerprint keep the same words, thus words that were
+   * filtered by one of them can be reused by the other. */
+  std::size_t fingerprint() const { return d_fingerprint; }
+
+private:
+  class WordTraits;
+  /*! \brief Check if the \a word must be kept.
+   * \param[in] word Word to check.
+   * \param[out] fragments Words that the \a word was split into are added
+   *                  to this list, the \a word is then not kept.
+   * \return True if the word must be kept. */
+  bool keepWord( const WordView& word, WordViewList& fragments ) const;
+
+  CppParserSettings::WhatToCheckOptions d_whatToCheck;
+  CppParserSettings::CommentsToCheckOptions d_commentsToCheck;
+  bool d_checkQtKeywords;
+  bool d_checkAllCapsWords;
+  CppParserSettings::WordsWithNumbersOption d_wordsWithNumberOption;
+  CppParserSettings::WordsWithUnderscoresOption d_wordsWithUnderscoresOption;
+  CppParserSettings::CamelCaseWordOption d_camelCaseWordOption;
+  bool d_removeWordsThatAppearInSource;
+  bool d_removeEmailAddresses;
+  CppParserSettings::WordsWithDotsOption d_wordsWithDotsOption;
+  bool d_removeWebsites;
+  bool d_removeFirstComment;
+  std::size_t d_fingerprint;
+};
+
+/*! \brief Shared, immutable filter plan. */
+using CppWordFilterPlanPtr = std::shared_ptr<const CppWordFilterPlan>;
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
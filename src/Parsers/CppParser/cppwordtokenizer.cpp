@@ -0,0 +1,279 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "cppparserconstants.h"
+#include "cppwordtokenizer.h"
+
+#include <QRegularExpression>
+#include <QtAlgorithms>
+
+#include <array>
+#include <cstdint>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define SP_TOKENIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace SpellChecker::CppSpellChecker::Internal;
+
+namespace {
+
+/*! \brief Classes that a character can belong to, used as flags. */
+enum CharClass : uint8_t {
+  WordChar    = 0x01, /*!< Letter, number or underscore. */
+  LetterChar  = 0x02, /*!< Letter. */
+  RegExpWord  = 0x04, /*!< Matches \w */
+  WebsiteChar = 0x08  /*!< Matches \w or a website character. */
+};
+
+/*! \brief Regular expression for characters that can be part of a website address. */
+const QRegularExpression& websiteCharsRegExp()
+{
+  static const QRegularExpression websiteChars( QStringLiteral( "\\w|" ) + QLatin1String( SpellChecker::Parsers::CppParser::Constants::WEBSITE_CHARS_REGEXP_PATTERN ) );
+  return websiteChars;
+}
+// --------------------------------------------------
+
+/*! \brief Regular expression for a word character. */
+const QRegularExpression& wordCharRegExp()
+{
+  static const QRegularExpression wordChars( QStringLiteral( "\\w" ) );
+  return wordChars;
+}
+// --------------------------------------------------
+
+/*! \brief Classify a character using QChar and the regular expressions.
+ *
+ * The regular expressions are matched against the character without copying
+ * it into a new string. */
+uint8_t classify( QChar character )
+{
+  const QString string = QString::fromRawData( &character, 1 );
+  uint8_t charClass    = 0;
+  if( ( character.isLetterOrNumber() == true )
+      || ( character == QLatin1Char( '_' ) ) ) {
+    charClass |= WordChar;
+  }
+  if( character.isLetter() == true ) {
+    charClass |= LetterChar;
+  }
+  if( wordCharRegExp().match( string ).hasMatch() == true ) {
+    charClass |= RegExpWord;
+  }
+  if( websiteCharsRegExp().match( string ).hasMatch() == true ) {
+    charClass |= WebsiteChar;
+  }
+  return charClass;
+}
+// --------------------------------------------------
+
+/*! \brief Table with the classes of the Latin-1 characters.
+ *
+ * The table is calculated using the same checks that are used for the other
+ * characters, thus the result is the same for all characters. */
+const std::array<uint8_t, 256>& latin1Classes()
+{
+  static const std::array<uint8_t, 256> table = []() {
+    std::array<uint8_t, 256> classes{};
+    for( uint32_t idx = 0; idx < classes.size(); ++idx ) {
+      classes[idx] = classify( QChar( char16_t( idx ) ) );
+    }
+    return classes;
+  }();
+  return table;
+}
+// --------------------------------------------------
+
+/*! \brief Check if the character has the given class.
+ *
+ * The table is used for Latin-1 characters. For other characters QChar is
+ * used for words and letters. The regular expressions are only used for the
+ * other classes, these are only checked for the characters next to a dot, '@'
+ * or website character. */
+bool hasClass( QChar character, CharClass charClass )
+{
+  const char16_t unicode = character.unicode();
+  if( unicode < 256 ) {
+    return ( latin1Classes()[unicode] & charClass ) != 0;
+  }
+  switch( charClass ) {
+    case WordChar:
+      return ( character.isLetterOrNumber() == true );
+    case LetterChar:
+      return ( character.isLetter() == true );
+    default:
+      return ( classify( character ) & charClass ) != 0;
+  }
+}
+// --------------------------------------------------
+
+#ifdef SP_TOKENIZER_SSE2
+/*! \brief Skip ASCII letters, numbers and underscores, 8 characters at a time.
+ * \return Position of the first character in the blocks of 8 that is not an
+ *              ASCII word character. This can be the start of the last block
+ *              that is shorter than 8 characters. */
+qsizetype skipAsciiWordChars( const char16_t* data, qsizetype position, qsizetype length )
+{
+  const __m128i beforeZero = _mm_set1_epi16( '0' - 1 );
+  const __m128i afterNine  = _mm_set1_epi16( '9' + 1 );
+  const __m128i beforeA    = _mm_set1_epi16( 'a' - 1 );
+  const __m128i afterZ     = _mm_set1_epi16( 'z' + 1 );
+  const __m128i lowerCase  = _mm_set1_epi16( 0x20 );
+  const __m128i underscore = _mm_set1_epi16( '_' );
+  while( position + 8 <= length ) {
+    /* Characters above 0x7FFF are negative in the signed compares and never
+     * fall in one of the ranges. */
+    const __m128i chars  = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + position ) );
+    const __m128i lower  = _mm_or_si128( chars, lowerCase );
+    const __m128i digit  = _mm_and_si128( _mm_cmpgt_epi16( chars, beforeZero ), _mm_cmplt_epi16( chars, afterNine ) );
+    const __m128i letter = _mm_and_si128( _mm_cmpgt_epi16( lower, beforeA ), _mm_cmplt_epi16( lower, afterZ ) );
+    const __m128i word   = _mm_or_si128( _mm_or_si128( digit, letter ), _mm_cmpeq_epi16( chars, underscore ) );
+    const uint32_t mask  = uint32_t( _mm_movemask_epi8( word ) );
+    if( mask != 0xFFFF ) {
+      /* Each character has 2 bits in the mask. */
+      return position + qCountTrailingZeroBits( ~mask ) / 2;
+    }
+    position += 8;
+  }
+  return position;
+}
+// --------------------------------------------------
+
+/*! \brief Skip ASCII white space and control characters, 8 characters at a time.
+ * \return Position of the first character in the blocks of 8 that is not
+ *              white space. */
+qsizetype skipAsciiSpaces( const char16_t* data, qsizetype position, qsizetype length )
+{
+  const __m128i beforeZero = _mm_set1_epi16( -1 );
+  const __m128i afterSpace = _mm_set1_epi16( ' ' + 1 );
+  while( position + 8 <= length ) {
+    const __m128i chars = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + position ) );
+    const __m128i space = _mm_and_si128( _mm_cmpgt_epi16( chars, beforeZero ), _mm_cmplt_epi16( chars, afterSpace ) );
+    const uint32_t mask = uint32_t( _mm_movemask_epi8( space ) );
+    if( mask != 0xFFFF ) {
+      return position + qCountTrailingZeroBits( ~mask ) / 2;
+    }
+    position += 8;
+  }
+  return position;
+}
+// --------------------------------------------------
+#endif /* SP_TOKENIZER_SSE2 */
+
+} // namespace
+
+CppWordTokenizer::CppWordTokenizer( bool websiteCharsInWords )
+  : d_websiteCharsInWords( websiteCharsInWords )
+{
+  /* Calculate the table up front, not while the first word is found. */
+  latin1Classes();
+}
+// --------------------------------------------------
+
+bool CppWordTokenizer::nextWord( QStringView string, qsizetype& position, qsizetype& wordStart ) const
+{
+  const qsizetype length = string.size();
+  qsizetype current      = position;
+  /* Find the start of the next word. */
+  while( current < length ) {
+#ifdef SP_TOKENIZER_SSE2
+    current = skipAsciiSpaces( string.utf16(), current, length );
+    if( current >= length ) {
+      break;
+    }
+#endif /* SP_TOKENIZER_SSE2 */
+    if( isEndOfWord( string, current ) == false ) {
+      break;
+    }
+    ++current;
+  }
+  if( current >= length ) {
+    position = length;
+    return false;
+  }
+  wordStart = current;
+  ++current;
+  /* Find the end of the word. The end of the string is always the end of a
+   * word. */
+  while( current < length ) {
+#ifdef SP_TOKENIZER_SSE2
+    current = skipAsciiWordChars( string.utf16(), current, length );
+    if( current >= length ) {
+      break;
+    }
+#endif /* SP_TOKENIZER_SSE2 */
+    if( isEndOfWord( string, current ) == true ) {
+      break;
+    }
+    ++current;
+  }
+  position = current;
+  return true;
+}
+// --------------------------------------------------
+
+bool CppWordTokenizer::isEndOfWord( QStringView string, qsizetype position ) const
+{
+  const qsizetype length = string.size();
+  if( position >= length ) {
+    return true;
+  }
+
+  const QChar currentChar = string[position];
+  if( hasClass( currentChar, WordChar ) == true ) {
+    return false;
+  }
+
+  /* All the other rules need a character before and after the current one. */
+  const bool isFirstOrLast = ( position == 0 ) || ( position == ( length - 1 ) );
+
+  /* Apostrophe in a word, for words like we're. */
+  if( currentChar == QLatin1Char( '\'' ) ) {
+    if( isFirstOrLast == true ) {
+      return true;
+    }
+    return ( hasClass( string[position + 1], LetterChar ) == false )
+           || ( hasClass( string[position - 1], LetterChar ) == false );
+  }
+
+  /* Dots in abbreviations and email addresses, and '@' in email addresses. */
+  if( ( currentChar == QLatin1Char( '.' ) )
+      || ( currentChar == QLatin1Char( '@' ) ) ) {
+    if( isFirstOrLast == true ) {
+      return true;
+    }
+    return ( hasClass( string[position + 1], RegExpWord ) == false )
+           || ( hasClass( string[position - 1], RegExpWord ) == false );
+  }
+
+  /* Website characters, only if they are part of words. */
+  if( ( d_websiteCharsInWords == true )
+      && ( hasClass( currentChar, WebsiteChar ) == true ) ) {
+    if( isFirstOrLast == true ) {
+      return true;
+    }
+    return ( hasClass( string[position + 1], WebsiteChar ) == false )
+           || ( hasClass( string[position - 1], WebsiteChar ) == false );
+  }
+
+  return true;
+}
+// --------------------------------------------------
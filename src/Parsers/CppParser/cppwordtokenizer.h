@@ -0,0 +1,71 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QStringView>
+
+namespace SpellChecker {
+namespace CppSpellChecker {
+namespace Internal {
+
+/*! \brief The C++ Word Tokenizer class.
+ *
+ * Finds the words in comments and string literals. A word is a run of
+ * characters that are not the end of a word according to isEndOfWord().
+ *
+ * The characters in the Latin-1 range are classified using a table that is
+ * calculated once. Other characters are classified using QChar. Runs of
+ * ASCII word characters and white space are skipped 8 characters at a time
+ * using SSE2, where it is available. Only the characters that need context,
+ * such as an apostrophe or a dot, are checked one at a time. */
+class CppWordTokenizer
+{
+public:
+  /*! \brief Constructor
+   * \param[in] websiteCharsInWords If characters that can be part of a
+   *              website address, such as '/' and ':', are part of a
+   *              word if they appear between word characters. */
+  explicit CppWordTokenizer( bool websiteCharsInWords = false );
+
+  /*! \brief Find the next word in the \a string.
+   * \param[in] string String to find the word in.
+   * \param[in,out] position Position to start searching from. This is set to
+   *              the end of the word that was found.
+   * \param[out] wordStart Start of the word that was found.
+   * \return True if a word was found, false if there are no more words. */
+  bool nextWord( QStringView string, qsizetype& position, qsizetype& wordStart ) const;
+  /*! \brief Check if the character at the \a position is the end of a word.
+   *
+   * Letters, numbers and underscores are part of a word. An apostrophe between
+   * two letters is part of a word, for words like we're. A dot or '@' between
+   * two word characters is part of a word, for abbreviations and email
+   * addresses. If website characters are part of words, they are part of a
+   * word between two word or website characters. Any other character, or a
+   * position past the end of the string, is the end of a word. */
+  bool isEndOfWord( QStringView string, qsizetype position ) const;
+
+private:
+  bool d_websiteCharsInWords;
+};
+
+} // namespace Internal
+} // namespace CppSpellChecker
+} // namespace SpellChecker
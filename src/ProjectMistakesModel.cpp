@@ -25,10 +25,12 @@
 
 #include <QFileInfo>
 
+#include <algorithm>
+
 using namespace SpellChecker::Internal;
 using namespace SpellChecker;
 
-using WordListInternalPair = QPair<SpellChecker::WordList, bool /* In Startup Project */>;
+using WordListInternalPair = QPair<SpellChecker::CompactWordListPtr, bool /* In Startup Project */>;
 using FileMistakes         = QMap<QString, WordListInternalPair>;
 
 class SpellChecker::Internal::ProjectMistakesModelPrivate
@@ -64,12 +66,13 @@ ProjectMistakesModel::~ProjectMistakesModel()
 }
 // --------------------------------------------------
 
-void ProjectMistakesModel::insertSpellingMistakes( const QString& fileName, const SpellChecker::WordList& words, bool inStartupProject )
+void ProjectMistakesModel::insertSpellingMistakes( const QString& fileName, const SpellChecker::CompactWordListPtr& words, bool inStartupProject )
 {
+  Q_ASSERT( words != nullptr );
   /* Check if the model already contains the file */
   FileMistakes::iterator file = d->spellingMistakes.find( fileName );
 
-  if( ( words.isEmpty() == true )
+  if( ( words->isEmpty() == true )
       && ( file == d->spellingMistakes.end() ) ) {
     /* The file was never added, no need to do anything */
     return;
@@ -77,7 +80,7 @@ void ProjectMistakesModel::insertSpellingMistakes( const QString& fileName, cons
 
   /* If there are no mistakes in the list of words, remove the file
    * from the model if it was found in the list of files. */
-  if( ( words.isEmpty() == true )
+  if( ( words->isEmpty() == true )
       && ( file != d->spellingMistakes.end() ) ) {
     int idx = indexOfFile( fileName );
     Q_ASSERT( idx != -1 );
@@ -92,7 +95,7 @@ void ProjectMistakesModel::insertSpellingMistakes( const QString& fileName, cons
   if( file != d->spellingMistakes.end() ) {
     /* The file was added with mistakes before, check if there are a change in the
      * total number of items. */
-    bool changed = ( file.value().first.count() != words.count() );
+    bool changed = ( file.value().first->count() != words->count() );
     /* Assign the words to the file */
     file.value().first = words;
     /* Notify of the change if there was one */
@@ -121,20 +124,37 @@ void ProjectMistakesModel::clearAllSpellingMistakes()
 }
 // --------------------------------------------------
 
-SpellChecker::WordList ProjectMistakesModel::mistakesForFile( const QString& fileName ) const
+SpellChecker::CompactWordListPtr ProjectMistakesModel::mistakesForFile( const QString& fileName ) const
 {
-  return d->spellingMistakes.value( fileName ).first;
+  static const CompactWordListPtr noMistakes = std::make_shared<const CompactWordList>();
+  const FileMistakes::const_iterator file = d->spellingMistakes.constFind( fileName );
+  if( file == d->spellingMistakes.constEnd() ) {
+    return noMistakes;
+  }
+  return file.value().first;
 }
 // --------------------------------------------------
 
 void ProjectMistakesModel::removeAllOccurrences( const QString& wordText )
 {
+  /* If the word was never interned, it can not be a mistake of any file. */
+  const StringInterner::Id wordId = StringInterner::words().find( wordText );
+  if( wordId == StringInterner::INVALID_ID ) {
+    return;
+  }
   beginResetModel();
   FileMistakes::Iterator iter = d->spellingMistakes.begin();
   while( iter != d->spellingMistakes.end() ) {
-    iter.value().first.remove( wordText );
+    /* The lists are shared with the other models, thus a new list without
+     * the word is created instead of changing the list. */
+    if( iter.value().first->contains( wordId ) == true ) {
+      auto words = std::make_shared<CompactWordList>( *iter.value().first );
+      words->removeIf( [wordId]( const CompactWord& word ) { return ( word.wordId == wordId ); } );
+      words->finalize();
+      iter.value().first = std::move( words );
+    }
     /* If there are no more words for the file, remove the file from the list */
-    if( iter.value().first.isEmpty() == true ) {
+    if( iter.value().first->isEmpty() == true ) {
       d->sortedKeys.removeAll( iter.key() );
       iter = d->spellingMistakes.erase( iter );
     } else {
@@ -145,12 +165,12 @@ void ProjectMistakesModel::removeAllOccurrences( const QString& wordText )
 }
 // --------------------------------------------------
 
-int ProjectMistakesModel::countStringLiterals( const SpellChecker::WordList& words ) const
+int ProjectMistakesModel::countStringLiterals( const SpellChecker::CompactWordList& words ) const
 {
   /* Count how many of the words for the given file are in String Literals. */
   int count = std::count_if( words.constBegin(),
                              words.constEnd(),
-                             []( const Word& word ) { return ( word.inComment == false ); } );
+                             []( const CompactWord& word ) { return ( word.inComment == 0 ); } );
   return count;
 }
 // --------------------------------------------------
@@ -196,17 +216,14 @@ void ProjectMistakesModel::fileSelected( const QModelIndex& index )
     Core::IEditor* editor = Core::EditorManager::openEditor( Utils::FilePath::fromString(fileName) );
     emit editorOpened();
     Q_ASSERT( editor != nullptr );
-    Q_ASSERT( d->spellingMistakes.value( fileName ).first.isEmpty() == false );
     /* Go to the first misspelled word in the editor. */
-    const SpellChecker::WordList words = d->spellingMistakes.value( fileName ).first;
-    Q_ASSERT( words.empty() == false );
-    /* Get a word on the first line with a spelling mistake and
-     * go to that line. This is to ensure that the highest up spelling
-     * mistake is selected instead of a random mistake randomly in the
-     * file. This seemed strange. */
-    const Word word = *std::min_element( words.begin(), words.end(), []( const Word& lhs, const Word& rhs ) {
-      return lhs.lineNumber < rhs.lineNumber;
-    } );
+    const SpellChecker::CompactWordListPtr words = mistakesForFile( fileName );
+    Q_ASSERT( words->empty() == false );
+    /* Go to the first spelling mistake in the file. This is to ensure that
+     * the highest up spelling mistake is selected instead of a random mistake
+     * randomly in the file. The mistakes are sorted by position thus this is
+     * the first word in the list. */
+    const CompactWord& word = words->first();
     editor->gotoLine( int32_t( word.lineNumber ), int32_t( word.columnNumber - 1 ) );
   }
 }
@@ -268,13 +285,13 @@ QVariant ProjectMistakesModel::data( const QModelIndex& index, int role ) const
     case COLUMN_FILE:
       return QFileInfo( iter.key() ).fileName();
     case COLUMN_MISTAKES_TOTAL:
-      return ( iter.value().first.count() );
+      return ( iter.value().first->count() );
     case COLUMN_FILEPATH:
       return iter.key();
     case COLUMN_FILE_IN_STARTUP:
       return ( iter.value().second );
     case COLUMN_LITERAL_COUNT:
-      return countStringLiterals( iter.value().first );
+      return countStringLiterals( *iter.value().first );
     case COLUMN_FILE_TYPE:
       return QFileInfo( iter.key() ).suffix();
     default:
@@ -322,7 +339,7 @@ void ProjectMistakesModel::sort( int column, Qt::SortOrder order )
         greaterThan = ( QFileInfo( iterLhs.key() ).fileName().toUpper() < QFileInfo( iterRhs.key() ).fileName().toUpper() );
         break;
       case COLUMN_MISTAKES_TOTAL:
-        greaterThan = ( iterLhs.value().first.count() < iterRhs.value().first.count() );
+        greaterThan = ( iterLhs.value().first->count() < iterRhs.value().first->count() );
         break;
       case COLUMN_FILEPATH:
         greaterThan = ( iterLhs.key().toUpper() < iterRhs.key().toUpper() );
@@ -331,8 +348,8 @@ void ProjectMistakesModel::sort( int column, Qt::SortOrder order )
         greaterThan = iterLhs.value().second;
         break;
       case COLUMN_LITERAL_COUNT: {
-        int countLhs = countStringLiterals( iterLhs.value().first );
-        int countRhs = countStringLiterals( iterRhs.value().first );
+        int countLhs = countStringLiterals( *iterLhs.value().first );
+        int countRhs = countStringLiterals( *iterRhs.value().first );
         greaterThan  = ( countLhs < countRhs );
         break;
       }
@@ -20,7 +20,7 @@
 
 #pragma once
 
-#include "Word.h"
+#include "CompactWord.h"
 
 #include <QAbstractItemModel>
 
@@ -68,7 +68,7 @@ public:
    * \param[in] fileName Name of the file that the words belong to.
    * \param[in] words Misspelled words for the file.
    * \param[in] inStartupProject If the file is part of the startup project, or external. */
-  void insertSpellingMistakes( const QString& fileName, const WordList& words, bool inStartupProject );
+  void insertSpellingMistakes( const QString& fileName, const CompactWordListPtr& words, bool inStartupProject );
   /*! \brief Clears all Spelling Mistakes added to the model.
    *
    * This would normally be done when the startup project gets changed.
@@ -77,11 +77,11 @@ public:
   /*! \brief Get all mistakes for a file
    *
    * If the file does not have any mistakes associated with it, this function will
-   * return a list of empty words.
+   * return an empty list of words, never a null pointer.
    * \param[in] fileName Name of the file.
    * \return A list of misspelled words for the file.
    */
-  WordList mistakesForFile( const QString& fileName ) const;
+  CompactWordListPtr mistakesForFile( const QString& fileName ) const;
   /*! \brief Remove all occurrences of the word.
    *
    * This function is used to remove all occurrences of the given word from
@@ -93,7 +93,7 @@ public:
   /*! \brief Count the number of String Literals in the list of words.
    * \param[in] words List of words that should be counted.
    * \return The number of words in the list that are in String Literals. */
-  int countStringLiterals( const WordList& words ) const;
+  int countStringLiterals( const CompactWordList& words ) const;
   /*! \brief Update the model to reflect internal vs external files.
    *
    * Since the model has a column for files part of the project, the model
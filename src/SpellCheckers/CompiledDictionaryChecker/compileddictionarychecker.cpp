@@ -0,0 +1,424 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "compileddictionarychecker.h"
+#include "compileddictionaryoptionswidget.h"
+#include "CompiledDictionaryConstants.h"
+#include "wordlookup.h"
+#include "wordtable.h"
+
+#include "../../spellcheckerconstants.h"
+
+#include <coreplugin/icore.h>
+#include <utils/qtcsettings.h>
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QSet>
+#include <QTextStream>
+
+#include <memory>
+
+/*! \brief Logging category for the mapping of the dictionary, enable it with
+ * QT_LOGGING_RULES="qtc.spellchecker.compileddictionary.debug=true". */
+static Q_LOGGING_CATEGORY( compiledDictionaryLog, "qtc.spellchecker.compileddictionary", QtWarningMsg )
+
+namespace {
+using SpellChecker::Checker::CompiledDictionary::WordTable;
+
+/*! \brief A compiled dictionary file that is mapped into memory.
+ *
+ * The mapping stays valid for the lifetime of the object, after which the
+ * file is unmapped and closed. */
+class MappedDictionary
+{
+public:
+  /*! \brief Open and map the compiled dictionary \a fileName.
+   * \param[in] fileName Compiled dictionary to open.
+   * \param[out] error Description of the problem if the file could not be used.
+   * \return True if the dictionary can be used. */
+  bool open( const QString& fileName, QString& error )
+  {
+    d_file.setFileName( fileName );
+    if( d_file.open( QIODevice::ReadOnly ) == false ) {
+      error = d_file.errorString();
+      return false;
+    }
+    const qint64 size = d_file.size();
+    const uchar* data = d_file.map( 0, size );
+    if( data == nullptr ) {
+      error = d_file.errorString();
+      return false;
+    }
+    return d_table.setData( data, size, &error );
+  }
+
+  const WordTable& table() const
+  {
+    return d_table;
+  }
+
+private:
+  QFile d_file;
+  WordTable d_table;
+};
+using MappedDictionaryPtr = std::shared_ptr<const MappedDictionary>;
+
+/*! \brief Word table of the words that were added or ignored by the user,
+ * along with the data that it is a view on. */
+struct SessionTable
+{
+  QByteArray data;
+  WordTable table;
+};
+using SessionTablePtr = std::shared_ptr<const SessionTable>;
+
+/*! \brief Immutable snapshot of all words known by the checker. */
+struct Snapshot
+{
+  MappedDictionaryPtr dictionary; /*!< Can be empty. */
+  SessionTablePtr sessionWords;   /*!< Can be empty. */
+
+  /*! \brief Check if the \a word is known, exactly as given. */
+  bool containsExact( QStringView word ) const
+  {
+    if( ( dictionary != nullptr )
+        && ( dictionary->table().contains( word ) == true ) ) {
+      return true;
+    }
+    return ( ( sessionWords != nullptr )
+             && ( sessionWords->table.contains( word ) == true ) );
+  }
+
+  /*! \brief Check if the \a word is known, using the case rules of Hunspell. */
+  bool isKnown( QStringView word ) const
+  {
+    using SpellChecker::Checker::CompiledDictionary::containsWithCaseRules;
+    return containsWithCaseRules( word, [this]( QStringView exactWord ) {
+      return containsExact( exactWord );
+    } );
+  }
+};
+using SnapshotPtr = std::shared_ptr<const Snapshot>;
+} // namespace
+
+class SpellChecker::Checker::CompiledDictionary::CompiledDictionaryCheckerPrivate
+{
+public:
+  QString dictionary;
+  QString userDictionary;
+  QMutex  fileMutex;
+  QMutex  publishMutex;              /*!< Serialises the publishing of snapshots, readers
+                                      * never take it. Also guards the members below. */
+  MappedDictionaryPtr mapped;        /*!< Current dictionary, can be empty. */
+  QSet<QString> sessionWords;        /*!< Words added or ignored by the user. */
+  QSet<QString> ignoredWords;        /*!< Words only ignored by the user, they are kept
+                                      * when the user dictionary changes. */
+  SessionTablePtr sessionTable;      /*!< Word table of the sessionWords. */
+  QMutex  snapshotMutex;             /*!< Guards the current pointer. */
+  SnapshotPtr current;               /*!< Current snapshot, never empty. */
+
+  CompiledDictionaryCheckerPrivate()
+    : dictionary()
+    , userDictionary()
+    , current( std::make_shared<Snapshot>() )
+  {}
+  ~CompiledDictionaryCheckerPrivate() {}
+
+  /*! \brief Get the current snapshot.
+   *
+   * A caller keeps the snapshot alive for as long as it uses it, even if
+   * a new dictionary gets loaded or words get added in between. */
+  SnapshotPtr snapshot()
+  {
+    QMutexLocker lock( &snapshotMutex );
+    return current;
+  }
+
+  /*! \brief Build the sessionTable from the sessionWords.
+   *
+   * The caller must hold the publishMutex. */
+  void buildSessionTable()
+  {
+    WordTableBuilder builder;
+    for( const QString& word: std::as_const( sessionWords ) ) {
+      builder.addWord( word );
+    }
+    auto table  = std::make_shared<SessionTable>();
+    table->data = builder.build();
+    table->table.setData( reinterpret_cast<const uchar*>( table->data.constData() ), table->data.size() );
+    sessionTable = table;
+  }
+
+  /*! \brief Publish the mapped dictionary and the sessionTable as the
+   * current snapshot.
+   *
+   * The caller must hold the publishMutex. */
+  void publish()
+  {
+    auto snapshot          = std::make_shared<Snapshot>();
+    snapshot->dictionary   = mapped;
+    snapshot->sessionWords = sessionTable;
+    QMutexLocker lock( &snapshotMutex );
+    current = snapshot;
+  }
+};
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+using namespace SpellChecker::Checker::CompiledDictionary;
+namespace DictionaryConstants = SpellChecker::SpellCheckers::CompiledDictionaryChecker::Constants;
+
+CompiledDictionaryChecker::CompiledDictionaryChecker()
+  : ISpellChecker()
+  , d( new CompiledDictionaryCheckerPrivate() )
+{
+  loadSettings();
+  loadDictionary();
+  loadUserAddedWords();
+}
+// --------------------------------------------------
+
+CompiledDictionaryChecker::~CompiledDictionaryChecker()
+{
+  stopBackgroundWork();
+  saveSettings();
+  delete d;
+}
+// --------------------------------------------------
+
+QString CompiledDictionaryChecker::name() const
+{
+  return tr( "Compiled Dictionary" );
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::loadSettings()
+{
+  Utils::QtcSettings* settings = Core::ICore::settings();
+  settings->beginGroup( Constants::CORE_SETTINGS_GROUP );
+  settings->beginGroup( Constants::CORE_SPELLCHECKERS_GROUP );
+  settings->beginGroup( DictionaryConstants::SETTINGS_GROUP );
+  d->dictionary     = settings->value( DictionaryConstants::SETTING_DICTIONARY, QLatin1String( "" ) ).toString();
+  d->userDictionary = settings->value( DictionaryConstants::SETTING_USER_DICTIONARY, QLatin1String( "" ) ).toString();
+  settings->endGroup();
+  settings->endGroup();
+  settings->endGroup();
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::saveSettings() const
+{
+  Utils::QtcSettings* settings = Core::ICore::settings();
+  settings->beginGroup( Constants::CORE_SETTINGS_GROUP );
+  settings->beginGroup( Constants::CORE_SPELLCHECKERS_GROUP );
+  settings->beginGroup( DictionaryConstants::SETTINGS_GROUP );
+  settings->setValue( DictionaryConstants::SETTING_DICTIONARY,      d->dictionary );
+  settings->setValue( DictionaryConstants::SETTING_USER_DICTIONARY, d->userDictionary );
+  settings->endGroup();
+  settings->endGroup();
+  settings->endGroup();
+  settings->sync();
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::loadDictionary()
+{
+  MappedDictionaryPtr mapped;
+  if( d->dictionary.isEmpty() == true ) {
+    qDebug() << "CompiledDictionary: Dictionary name empty";
+  } else {
+    QElapsedTimer timer;
+    timer.start();
+    auto dictionary = std::make_shared<MappedDictionary>();
+    QString error;
+    if( dictionary->open( d->dictionary, error ) == true ) {
+      qCDebug( compiledDictionaryLog ) << "Mapped" << d->dictionary << "with"
+                                       << dictionary->table().wordCount() << "words in" << timer.elapsed() << "ms";
+      mapped = dictionary;
+    } else {
+      qDebug() << "CompiledDictionary: Could not load" << d->dictionary << ":" << error;
+    }
+  }
+
+  QMutexLocker lock( &d->publishMutex );
+  d->mapped = mapped;
+  d->publish();
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::loadUserAddedWords()
+{
+  QStringList userWords;
+  if( d->userDictionary.isEmpty() == true ) {
+    qDebug() << "loadUserAddedWords: User dictionary name empty";
+  } else {
+    QMutexLocker lock( &d->fileMutex );
+    QFile dictionary( d->userDictionary );
+    if( dictionary.open( QIODevice::ReadOnly ) == true ) {
+      QTextStream stream( &dictionary );
+      while( stream.atEnd() != true ) {
+        const QString word = stream.readLine();
+        if( word.isEmpty() == false ) {
+          userWords << word;
+        }
+      }
+      dictionary.close();
+    } else {
+      qDebug() << "loadUserAddedWords: Could not open user dictionary file: " << d->userDictionary;
+    }
+  }
+
+  /* The words of a previous user dictionary must not stay known, only the
+   * ignored words are kept. */
+  QMutexLocker lock( &d->publishMutex );
+  d->sessionWords = d->ignoredWords;
+  for( const QString& word: std::as_const( userWords ) ) {
+    d->sessionWords.insert( word );
+  }
+  d->buildSessionTable();
+  d->publish();
+}
+// --------------------------------------------------
+
+bool CompiledDictionaryChecker::isSpellingMistake( const QString& word ) const
+{
+  return ( d->snapshot()->isKnown( word ) == false );
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const
+{
+  mistakes = QBitArray( words.size() );
+  /* The snapshot is only taken once for the whole batch. */
+  const SnapshotPtr snapshot = d->snapshot();
+  for( qsizetype index = 0; index < words.size(); ++index ) {
+    if( snapshot->isKnown( words.at( index ) ) == false ) {
+      mistakes.setBit( index );
+    }
+  }
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::getSuggestionsForWord( const QString& word, QStringList& suggestionsList ) const
+{
+  const SnapshotPtr snapshot = d->snapshot();
+  QString tryCharacters;
+  if( snapshot->dictionary != nullptr ) {
+    tryCharacters = snapshot->dictionary->table().tryCharacters();
+  }
+  if( tryCharacters.isEmpty() == true ) {
+    tryCharacters = DEFAULT_TRY_CHARACTERS;
+  }
+  suggestionsList = makeSuggestions( word, tryCharacters, [&snapshot]( const QString& candidate ) {
+    return snapshot->isKnown( candidate );
+  }, DictionaryConstants::MAX_SUGGESTIONS );
+}
+// --------------------------------------------------
+
+bool CompiledDictionaryChecker::addWord( const QString& word )
+{
+  /* Save the word to the user dictionary */
+  if( d->userDictionary.isEmpty() == true ) {
+    qDebug() << "User dictionary name empty";
+    return false;
+  }
+
+  QMutexLocker lock( &d->fileMutex );
+  QFileInfo( d->userDictionary ).dir().mkpath( "." );
+  QFile dictionary( d->userDictionary );
+  if( dictionary.open( QIODevice::Append ) == false ) {
+    qDebug() << "Could not open user dictionary file: " << d->userDictionary;
+    return false;
+  }
+  /* Only add the word to the spellchecker if the previous checks passed. */
+  {
+    QMutexLocker publishLock( &d->publishMutex );
+    d->sessionWords.insert( word );
+    d->buildSessionTable();
+    d->publish();
+  }
+  invalidateCaches();
+
+  QTextStream stream( &dictionary );
+  stream << word << Qt::endl;
+  dictionary.close();
+  return true;
+}
+// --------------------------------------------------
+
+bool CompiledDictionaryChecker::ignoreWord( const QString& word )
+{
+  /* The compiled dictionary can not change, the word is only added to the
+   * words of this session. */
+  {
+    QMutexLocker lock( &d->publishMutex );
+    d->sessionWords.insert( word );
+    d->ignoredWords.insert( word );
+    d->buildSessionTable();
+    d->publish();
+  }
+  invalidateCaches();
+  return true;
+}
+// --------------------------------------------------
+
+SpellChecker::IOptionsWidget* CompiledDictionaryChecker::optionsWidget()
+{
+  CompiledDictionaryOptionsWidget* widget = new CompiledDictionaryOptionsWidget( d->dictionary, d->userDictionary );
+  connect( this,   &CompiledDictionaryChecker::dictionaryChanged,               widget, &CompiledDictionaryOptionsWidget::updateDictionary );
+  connect( this,   &CompiledDictionaryChecker::userDictionaryChanged,           widget, &CompiledDictionaryOptionsWidget::updateUserDictionary );
+  connect( widget, &CompiledDictionaryOptionsWidget::dictionaryChanged,     this,   &CompiledDictionaryChecker::updateDictionary );
+  connect( widget, &CompiledDictionaryOptionsWidget::userDictionaryChanged, this,   &CompiledDictionaryChecker::updateUserDictionary );
+  return widget;
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::updateDictionary( const QString& dictionary )
+{
+  if( d->dictionary != dictionary ) {
+    d->dictionary = dictionary;
+    emit dictionaryChanged( d->dictionary );
+    /* Mapping the dictionary is fast enough to do it immediately. Jobs that
+     * still use the previous dictionary keep it alive until they are done. */
+    loadDictionary();
+    invalidateCaches();
+    emit dictionaryReloaded();
+  }
+}
+// --------------------------------------------------
+
+void CompiledDictionaryChecker::updateUserDictionary( const QString& userDictionary )
+{
+  if( d->userDictionary != userDictionary ) {
+    d->userDictionary = userDictionary;
+    emit userDictionaryChanged( d->userDictionary );
+    loadUserAddedWords();
+    invalidateCaches();
+    emit dictionaryReloaded();
+  }
+}
+// --------------------------------------------------
@@ -0,0 +1,82 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "../../ISpellChecker.h"
+
+#include <QObject>
+
+namespace SpellChecker {
+namespace Checker {
+namespace CompiledDictionary {
+
+class CompiledDictionaryCheckerPrivate;
+/*! \brief Spell checker that uses a compiled dictionary.
+ *
+ * A compiled dictionary is created offline from a Hunspell dictionary using
+ * the spellchecker-dictionary-compiler tool. It contains all words of the
+ * dictionary with their affix forms already expanded, in a WordTable that
+ * is memory mapped read only. Loading the dictionary is near instant and all
+ * threads share the same copy in the page cache.
+ *
+ * Words that are added or ignored are kept in a separate small word table,
+ * since the compiled dictionary can not be changed. Both are published as an
+ * immutable snapshot. A query only takes a mutex to copy the pointer to the
+ * snapshot, the lookups themselves take no lock and a word is looked up in
+ * both tables without converting it to a QString. */
+class CompiledDictionaryChecker
+  : public SpellChecker::ISpellChecker
+{
+  Q_OBJECT
+public:
+  CompiledDictionaryChecker();
+  ~CompiledDictionaryChecker() override;
+
+  QString name() const Q_DECL_OVERRIDE;
+  bool isSpellingMistake( const QString& word ) const Q_DECL_OVERRIDE;
+  void checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const Q_DECL_OVERRIDE;
+  void getSuggestionsForWord( const QString& word, QStringList& suggestionsList ) const Q_DECL_OVERRIDE;
+  bool addWord( const QString& word ) Q_DECL_OVERRIDE;
+  bool ignoreWord( const QString& word ) Q_DECL_OVERRIDE;
+  IOptionsWidget* optionsWidget() Q_DECL_OVERRIDE;
+
+signals:
+  void dictionaryChanged( const QString& dictionary );
+  void userDictionaryChanged( const QString& userDictionary );
+
+public slots:
+  void updateDictionary( const QString& dictionary );
+  void updateUserDictionary( const QString& userDictionary );
+
+private:
+  void loadSettings();
+  void saveSettings() const;
+  /*! \brief Map the compiled dictionary and publish it as the dictionary to use. */
+  void loadDictionary();
+  /*! \brief Set the words of the session to the ignored words and the words
+   * from the user dictionary. */
+  void loadUserAddedWords();
+  CompiledDictionaryCheckerPrivate* const d;
+};
+
+} // namespace CompiledDictionary
+} // namespace Checker
+} // namespace SpellChecker
@@ -0,0 +1,136 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "compileddictionaryoptionswidget.h"
+#include "ui_compileddictionaryoptionswidget.h"
+
+#include <coreplugin/icore.h>
+
+#include <QFileDialog>
+#include <QRegularExpression>
+
+using namespace SpellChecker::Checker::CompiledDictionary;
+
+CompiledDictionaryOptionsWidget::CompiledDictionaryOptionsWidget( const QString& dictionary, const QString& userDictionary, QWidget* parent )
+  : IOptionsWidget()
+  , ui( new Ui::CompiledDictionaryOptionsWidget )
+{
+  ui->setupUi( this );
+  connect( ui->toolButtonBrowseDictionary,     &QToolButton::clicked, this, &CompiledDictionaryOptionsWidget::toolButtonBrowseDictionaryClicked );
+  connect( ui->toolButtonBrowseUserDictionary, &QToolButton::clicked, this, &CompiledDictionaryOptionsWidget::toolButtonBrowseUserDictionaryClicked );
+
+  /* Set the hints on the different Dictionaries */
+  ui->lineEditDictionary->setToolTip( tr( "The dictionary is a *.spcdict file that was compiled from a Hunspell \n"
+                                          "dictionary using the spellchecker-dictionary-compiler tool. \n"
+                                          "A compiled dictionary loads almost instantly and is shared between all threads." ) );
+  ui->lineEditUserDictionary->setToolTip( tr( "The User Dictionary is a custom user dictionary that the spellchecker \n"
+                                              "will use to remember words that get added to the dictionary. \n"
+                                              "If such a file does not already exist, it will get created with the given information. " ) );
+
+  updateDictionary( dictionary );
+  updateUserDictionary( userDictionary );
+}
+// --------------------------------------------------
+
+CompiledDictionaryOptionsWidget::~CompiledDictionaryOptionsWidget()
+{
+  delete ui;
+}
+// --------------------------------------------------
+
+void CompiledDictionaryOptionsWidget::apply()
+{
+  /* Make sure the dictionaries exist */
+  QFileInfo dict( ui->lineEditDictionary->text() );
+  if( dict.exists() == true ) {
+    emit dictionaryChanged( ui->lineEditDictionary->text() );
+  } else {
+    emit optionsError( QLatin1String( "Compiled Dictionary Spellchecker" ), tr( "Dictionary does not exist" ) );
+    return;
+  }
+
+  QFileInfo userDict( ui->lineEditUserDictionary->text() );
+  if( userDict.dir().mkpath( "." ) == false ) {
+    emit optionsError( QLatin1String( "Compiled Dictionary Spellchecker" ), tr( "Path to user dictionary could not be created" ) );
+    return;
+  }
+  /* The Dir should exist at this point, check if the file exists and can be made if it does not */
+  if( userDict.exists() == false ) {
+    QFile file( ui->lineEditUserDictionary->text() );
+    if( file.open( QFile::ReadWrite | QFile::Text ) == false ) {
+      emit optionsError( QLatin1String( "Compiled Dictionary Spellchecker" ), tr( "User dictionary can not be created, perhaps insufficient access on folder." ) );
+      return;
+    }
+  }
+  /* At this point the user dictionary specified should be valid. */
+  emit userDictionaryChanged( ui->lineEditUserDictionary->text() );
+}
+// --------------------------------------------------
+
+void CompiledDictionaryOptionsWidget::updateDictionary( const QString& dictionary )
+{
+  ui->lineEditDictionary->setText( dictionary );
+  /* Derive a user dictionary name from the selected dictionary if none is
+   * set yet. The same name as for the Hunspell dictionary it was compiled
+   * from is used, so that words added with either checker are shared. */
+  if( ( ui->lineEditUserDictionary->text().isEmpty() == true )
+      && ( dictionary.isEmpty() == false ) ) {
+    QFileInfo fileInfo( dictionary );
+    QString   userDictFileName = fileInfo.fileName();
+    userDictFileName.replace( QRegularExpression( QLatin1String( "\\.spcdict$" ) ), QLatin1String( ".udic" ) );
+    userDictFileName = QLatin1String( "QtC-" ) + userDictFileName;
+    /* Add the file name to the User Resource Path */
+    QString userDictName = Core::ICore::userResourcePath().toString() + QLatin1String( "/UserDictionaries/" ) + userDictFileName;
+    updateUserDictionary( userDictName );
+  }
+}
+// --------------------------------------------------
+
+void CompiledDictionaryOptionsWidget::updateUserDictionary( const QString& userDictionary )
+{
+  ui->lineEditUserDictionary->setText( userDictionary );
+}
+// --------------------------------------------------
+
+void CompiledDictionaryOptionsWidget::toolButtonBrowseDictionaryClicked()
+{
+  QString dictionary = QFileDialog::getOpenFileName( this,
+                                                     tr( "Compiled Dictionary File" ),
+                                                     ui->lineEditDictionary->text(),
+                                                     tr( "Compiled Dictionaries (*.spcdict)" ),
+                                                     0,
+                                                     QFileDialog::ReadOnly );
+  if( dictionary.isEmpty() == false ) {
+    updateDictionary( dictionary );
+  }
+}
+// --------------------------------------------------
+
+void CompiledDictionaryOptionsWidget::toolButtonBrowseUserDictionaryClicked()
+{
+  QString userDictionary = QFileDialog::getSaveFileName( this,
+                                                         tr( "User Dictionary File" ),
+                                                         ui->lineEditUserDictionary->text(),
+                                                         tr( "Dictionaries (*.udic)" ));
+  if( userDictionary.isEmpty() == false ) {
+    updateUserDictionary( userDictionary );
+  }
+}
+// --------------------------------------------------
@@ -0,0 +1,165 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include <utility>
+
+namespace SpellChecker {
+namespace Checker {
+namespace CompiledDictionary {
+
+/*! \brief Characters tried when making suggestions if a dictionary does not
+ * specify its own. This is the TRY line of the common English dictionaries. */
+inline const QString DEFAULT_TRY_CHARACTERS = QStringLiteral( "esianrtolcdugmphbyfvkwzESIANRTOLCDUGMPHBYFVKWZ'" );
+
+/*! \brief Check if a word is known, using the same case rules as Hunspell.
+ *
+ * A word is known if it is in the dictionary as is. A capitalised word, like
+ * the first word of a sentence, is also known if its lower case form is in the
+ * dictionary. A word in all capitals is also known if its lower case or
+ * capitalised form is in the dictionary.
+ * \param[in] word Word to check.
+ * \param[in] contains Function that checks if a word is in the dictionary
+ *              exactly as given.
+ * \return True if the word is known. */
+template<typename Contains>
+bool containsWithCaseRules( QStringView word, const Contains& contains )
+{
+  if( contains( word ) == true ) {
+    return true;
+  }
+  if( word.isEmpty() == true ) {
+    return false;
+  }
+
+  bool restHasUpper = false;
+  bool restHasLower = false;
+  for( qsizetype index = 1; index < word.size(); ++index ) {
+    const QChar character = word.at( index );
+    restHasUpper |= character.isUpper();
+    restHasLower |= character.isLower();
+  }
+  const bool firstIsUpper = word.at( 0 ).isUpper();
+  if( firstIsUpper == false ) {
+    return false;
+  }
+
+  if( restHasUpper == false ) {
+    /* Capitalised word, or a single capital letter. */
+    const QString lower = word.toString().toLower();
+    return contains( QStringView( lower ) );
+  }
+  if( restHasLower == false ) {
+    /* All capitals. */
+    const QString lower = word.toString().toLower();
+    if( contains( QStringView( lower ) ) == true ) {
+      return true;
+    }
+    QString capitalised = lower;
+    capitalised[0]      = capitalised.at( 0 ).toUpper();
+    return contains( QStringView( capitalised ) );
+  }
+  return false;
+}
+// --------------------------------------------------
+
+/*! \brief Make suggestions for a misspelled word.
+ *
+ * The suggestions are all known words that are a single edit away from the
+ * misspelled word: two swapped characters, a replaced character, a removed
+ * character, an extra character, or a missing space. This is a lot simpler
+ * than what Hunspell does, but it catches the common typing mistakes.
+ * \param[in] word Misspelled word.
+ * \param[in] tryCharacters Characters to try for replaced and extra characters,
+ *              ordered from most to least common.
+ * \param[in] isKnown Function that checks if a word is known.
+ * \param[in] maxSuggestions Maximum number of suggestions to make.
+ * \return List of suggestions, the most likely ones first. */
+template<typename IsKnown>
+QStringList makeSuggestions( const QString& word, const QString& tryCharacters, const IsKnown& isKnown, int maxSuggestions )
+{
+  QStringList suggestions;
+  QSet<QString> tried;
+  auto tryCandidate = [&]( const QString& candidate ) {
+    if( ( suggestions.size() >= maxSuggestions )
+        || ( candidate.isEmpty() == true )
+        || ( candidate == word ) ) {
+      return;
+    }
+    if( tried.contains( candidate ) == true ) {
+      return;
+    }
+    tried.insert( candidate );
+    if( isKnown( candidate ) == true ) {
+      suggestions << candidate;
+    }
+  };
+
+  const qsizetype length = word.size();
+  /* Wrong case. */
+  tryCandidate( word.toLower() );
+  /* Swapped characters. */
+  for( qsizetype index = 0; index + 1 < length; ++index ) {
+    QString candidate = word;
+    std::swap( candidate[index], candidate[index + 1] );
+    tryCandidate( candidate );
+  }
+  /* Wrong character. */
+  for( qsizetype index = 0; index < length; ++index ) {
+    for( const QChar character: tryCharacters ) {
+      if( character != word.at( index ) ) {
+        QString candidate = word;
+        candidate[index]  = character;
+        tryCandidate( candidate );
+      }
+    }
+  }
+  /* Extra character. */
+  for( qsizetype index = 0; index < length; ++index ) {
+    tryCandidate( QString( word ).remove( index, 1 ) );
+  }
+  /* Missing character. */
+  for( qsizetype index = 0; index <= length; ++index ) {
+    for( const QChar character: tryCharacters ) {
+      tryCandidate( QString( word ).insert( index, character ) );
+    }
+  }
+  /* Missing space, both parts must be known words. */
+  for( qsizetype index = 1; ( index < length ) && ( suggestions.size() < maxSuggestions ); ++index ) {
+    const QString first  = word.left( index );
+    const QString second = word.mid( index );
+    if( ( isKnown( first ) == true )
+        && ( isKnown( second ) == true ) ) {
+      suggestions << first + QLatin1Char( ' ' ) + second;
+    }
+  }
+  return suggestions;
+}
+// --------------------------------------------------
+
+} // namespace CompiledDictionary
+} // namespace Checker
+} // namespace SpellChecker
@@ -0,0 +1,300 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "wordtable.h"
+
+#include <QCoreApplication>
+#include <QVarLengthArray>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SpellChecker::Checker::CompiledDictionary;
+
+namespace {
+/*! \brief Buffer type used to encode words to UTF-8 without allocating memory
+ * for most words. */
+using Utf8Buffer = QVarLengthArray<char, 128>;
+
+/*! \brief Encode the \a word as UTF-8 into the \a buffer.
+ *
+ * This gives the same result as QString::toUtf8(), but does not need to
+ * allocate memory for each word that gets looked up. */
+void encodeUtf8( QStringView word, Utf8Buffer& buffer )
+{
+  buffer.clear();
+  const qsizetype size = word.size();
+  for( qsizetype index = 0; index < size; ++index ) {
+    char32_t code = word.at( index ).unicode();
+    if( QChar::isSurrogate( code ) == true ) {
+      if( ( QChar::isHighSurrogate( code ) == true )
+          && ( index + 1 < size )
+          && ( word.at( index + 1 ).isLowSurrogate() == true ) ) {
+        code = QChar::surrogateToUcs4( char16_t( code ), word.at( index + 1 ).unicode() );
+        ++index;
+      } else {
+        code = QChar::ReplacementCharacter;
+      }
+    }
+    if( code < 0x80 ) {
+      buffer.append( char( code ) );
+    } else if( code < 0x800 ) {
+      buffer.append( char( 0xC0 | ( code >> 6 ) ) );
+      buffer.append( char( 0x80 | ( code & 0x3F ) ) );
+    } else if( code < 0x10000 ) {
+      buffer.append( char( 0xE0 | ( code >> 12 ) ) );
+      buffer.append( char( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+      buffer.append( char( 0x80 | ( code & 0x3F ) ) );
+    } else {
+      buffer.append( char( 0xF0 | ( code >> 18 ) ) );
+      buffer.append( char( 0x80 | ( ( code >> 12 ) & 0x3F ) ) );
+      buffer.append( char( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+      buffer.append( char( 0x80 | ( code & 0x3F ) ) );
+    }
+  }
+}
+// --------------------------------------------------
+
+/*! \brief Round \a value up to the next multiple of 8. */
+constexpr uint32_t align8( uint32_t value )
+{
+  return ( value + 7u ) & ~7u;
+}
+// --------------------------------------------------
+
+void setError( QString* error, const QString& message )
+{
+  if( error != nullptr ) {
+    *error = message;
+  }
+}
+// --------------------------------------------------
+} // namespace
+
+uint64_t WordTable::hash( QByteArrayView word )
+{
+  uint64_t value = 14695981039346656037ull;
+  for( const char character: word ) {
+    value ^= uchar( character );
+    value *= 1099511628211ull;
+  }
+  return value;
+}
+// --------------------------------------------------
+
+bool WordTable::setData( const uchar* data, qint64 size, QString* error )
+{
+  using namespace WordTableFormat;
+  *this = WordTable();
+  if( ( data == nullptr )
+      || ( size < qint64( sizeof( Header ) ) ) ) {
+    setError( error, QCoreApplication::translate( "WordTable", "File too small to be a word table" ) );
+    return false;
+  }
+
+  Header header;
+  std::memcpy( &header, data, sizeof( Header ) );
+  if( std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 ) {
+    setError( error, QCoreApplication::translate( "WordTable", "File is not a compiled dictionary" ) );
+    return false;
+  }
+  const uint32_t version       = qFromLittleEndian( header.version );
+  const uint32_t wordCount     = qFromLittleEndian( header.wordCount );
+  const uint32_t bucketCount   = qFromLittleEndian( header.bucketCount );
+  const uint32_t bucketsOffset = qFromLittleEndian( header.bucketsOffset );
+  const uint32_t stringsOffset = qFromLittleEndian( header.stringsOffset );
+  const uint32_t stringsSize   = qFromLittleEndian( header.stringsSize );
+  const uint32_t tryOffset     = qFromLittleEndian( header.tryOffset );
+  const uint32_t trySize       = qFromLittleEndian( header.trySize );
+  if( version != VERSION ) {
+    setError( error, QCoreApplication::translate( "WordTable", "Unsupported compiled dictionary version %1" ).arg( version ) );
+    return false;
+  }
+  /* The lookup relies on empty buckets to terminate, thus there must always
+   * be more buckets than words. */
+  if( ( bucketCount == 0 )
+      || ( ( bucketCount & ( bucketCount - 1 ) ) != 0 )
+      || ( bucketCount <= wordCount ) ) {
+    setError( error, QCoreApplication::translate( "WordTable", "Invalid hash table in compiled dictionary" ) );
+    return false;
+  }
+  if( ( ( bucketsOffset % alignof( Bucket ) ) != 0 )
+      || ( qint64( bucketsOffset ) + qint64( bucketCount ) * qint64( sizeof( Bucket ) ) > size )
+      || ( qint64( stringsOffset ) + qint64( stringsSize ) > size )
+      || ( qint64( tryOffset ) + qint64( trySize ) > size ) ) {
+    setError( error, QCoreApplication::translate( "WordTable", "Compiled dictionary is truncated" ) );
+    return false;
+  }
+
+  d_buckets       = reinterpret_cast<const Bucket*>( data + bucketsOffset );
+  d_strings       = data + stringsOffset;
+  d_stringsSize   = stringsSize;
+  d_mask          = bucketCount - 1;
+  d_wordCount     = wordCount;
+  d_tryCharacters = QString::fromUtf8( reinterpret_cast<const char*>( data + tryOffset ), trySize );
+  return true;
+}
+// --------------------------------------------------
+
+bool WordTable::isValid() const
+{
+  return ( d_buckets != nullptr );
+}
+// --------------------------------------------------
+
+bool WordTable::contains( QByteArrayView word ) const
+{
+  if( d_buckets == nullptr ) {
+    return false;
+  }
+  const uint64_t wordHash = hash( word );
+  const uint32_t tag      = uint32_t( wordHash >> 32 );
+  uint32_t index          = uint32_t( wordHash ) & d_mask;
+  /* The probe is limited to the size of the table, a damaged file must not
+   * result in an endless loop. */
+  for( uint32_t probe = 0; probe <= d_mask; ++probe, index = ( index + 1 ) & d_mask ) {
+    const uint32_t offset = qFromLittleEndian( d_buckets[index].offset );
+    if( offset == 0 ) {
+      return false;
+    }
+    if( qFromLittleEndian( d_buckets[index].tag ) != tag ) {
+      continue;
+    }
+    /* Offsets are stored plus one, to use 0 as the empty marker. */
+    const uint32_t start = offset - 1;
+    if( start + sizeof( uint16_t ) > d_stringsSize ) {
+      return false;
+    }
+    const uint16_t length = qFromLittleEndian<uint16_t>( d_strings + start );
+    if( ( length == word.size() )
+        && ( start + sizeof( uint16_t ) + length <= d_stringsSize )
+        && ( std::memcmp( d_strings + start + sizeof( uint16_t ), word.data(), length ) == 0 ) ) {
+      return true;
+    }
+  }
+  return false;
+}
+// --------------------------------------------------
+
+bool WordTable::contains( QStringView word ) const
+{
+  Utf8Buffer buffer;
+  encodeUtf8( word, buffer );
+  return contains( QByteArrayView( buffer.constData(), buffer.size() ) );
+}
+// --------------------------------------------------
+
+uint32_t WordTable::wordCount() const
+{
+  return d_wordCount;
+}
+// --------------------------------------------------
+
+QString WordTable::tryCharacters() const
+{
+  return d_tryCharacters;
+}
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+void WordTableBuilder::addWord( const QString& word )
+{
+  QByteArray utf8 = word.toUtf8();
+  /* The length of a word is stored as a 16 bit value. Words that long are
+   * not real words anyway. */
+  if( ( utf8.isEmpty() == true )
+      || ( utf8.size() > 0xFFFF ) ) {
+    return;
+  }
+  d_words.insert( utf8 );
+}
+// --------------------------------------------------
+
+void WordTableBuilder::setTryCharacters( const QString& characters )
+{
+  d_tryCharacters = characters;
+}
+// --------------------------------------------------
+
+qsizetype WordTableBuilder::wordCount() const
+{
+  return d_words.size();
+}
+// --------------------------------------------------
+
+QByteArray WordTableBuilder::build() const
+{
+  using namespace WordTableFormat;
+  /* Sort the words so that the same input always gives the same output. */
+  QList<QByteArray> words = d_words.values();
+  std::sort( words.begin(), words.end() );
+
+  /* Keep the load factor of the table at or below a half. This keeps the
+   * probe sequences short, for both words that are in the table and words
+   * that are not. */
+  uint32_t bucketCount = 8;
+  while( bucketCount < 2 * uint32_t( words.size() ) ) {
+    bucketCount *= 2;
+  }
+
+  QByteArray strings;
+  QVector<Bucket> buckets( bucketCount, Bucket{ 0, 0 } );
+  const uint32_t mask = bucketCount - 1;
+  for( const QByteArray& word: std::as_const( words ) ) {
+    const uint32_t offset = uint32_t( strings.size() );
+    uchar length[sizeof( uint16_t )];
+    qToLittleEndian<uint16_t>( uint16_t( word.size() ), length );
+    strings.append( reinterpret_cast<const char*>( length ), sizeof( length ) );
+    strings.append( word );
+
+    const uint64_t wordHash = WordTable::hash( word );
+    uint32_t index          = uint32_t( wordHash ) & mask;
+    while( buckets[index].offset != 0 ) {
+      index = ( index + 1 ) & mask;
+    }
+    buckets[index].tag    = qToLittleEndian( uint32_t( wordHash >> 32 ) );
+    buckets[index].offset = qToLittleEndian( offset + 1 );
+  }
+
+  const QByteArray tryCharacters = d_tryCharacters.toUtf8();
+  Header header;
+  std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+  const uint32_t bucketsOffset = align8( sizeof( Header ) );
+  const uint32_t stringsOffset = bucketsOffset + bucketCount * sizeof( Bucket );
+  const uint32_t tryOffset     = align8( stringsOffset + uint32_t( strings.size() ) );
+  header.version       = qToLittleEndian( VERSION );
+  header.wordCount     = qToLittleEndian( uint32_t( words.size() ) );
+  header.bucketCount   = qToLittleEndian( bucketCount );
+  header.bucketsOffset = qToLittleEndian( bucketsOffset );
+  header.stringsOffset = qToLittleEndian( stringsOffset );
+  header.stringsSize   = qToLittleEndian( uint32_t( strings.size() ) );
+  header.tryOffset     = qToLittleEndian( tryOffset );
+  header.trySize       = qToLittleEndian( uint32_t( tryCharacters.size() ) );
+
+  QByteArray data( tryOffset + tryCharacters.size(), '\0' );
+  std::memcpy( data.data(), &header, sizeof( Header ) );
+  std::memcpy( data.data() + bucketsOffset, buckets.constData(), bucketCount * sizeof( Bucket ) );
+  std::memcpy( data.data() + stringsOffset, strings.constData(), strings.size() );
+  std::memcpy( data.data() + tryOffset, tryCharacters.constData(), tryCharacters.size() );
+  return data;
+}
+// --------------------------------------------------
@@ -0,0 +1,148 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QSet>
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+
+namespace SpellChecker {
+namespace Checker {
+namespace CompiledDictionary {
+
+/*! \brief Binary layout of a compiled word table.
+ *
+ * The word table is a flat open addressing hash table over a blob of UTF-8
+ * strings. The table never needs to be parsed, it can be used directly from
+ * a memory mapped file or from a byte array in memory. All values are stored
+ * in little endian byte order and all sections are 8 byte aligned.
+ *
+ * The file consists of:
+ *  - The Header.
+ *  - The buckets of the hash table, Header::bucketCount of them. The number
+ *    of buckets is a power of 2 and at least twice the number of words.
+ *  - The strings, each stored as a 16 bit length followed by the UTF-8
+ *    bytes of the word.
+ *  - The characters to try when making suggestions, as UTF-8. */
+namespace WordTableFormat {
+
+constexpr char MAGIC[8]  = { 'S', 'P', 'C', 'D', 'I', 'C', 'T', '\0' };
+constexpr uint32_t VERSION = 1;
+
+struct Header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t wordCount;
+  uint32_t bucketCount;
+  uint32_t bucketsOffset;
+  uint32_t stringsOffset;
+  uint32_t stringsSize;
+  uint32_t tryOffset;
+  uint32_t trySize;
+};
+static_assert( sizeof( Header ) == 40, "Header layout changed" );
+
+/*! \brief A bucket of the hash table.
+ *
+ * The \a tag is the upper 32 bits of the hash of the word and is used to
+ * skip most string comparisons. The \a offset is the offset of the word in
+ * the strings section plus one, an offset of 0 marks an empty bucket. */
+struct Bucket
+{
+  uint32_t tag;
+  uint32_t offset;
+};
+static_assert( sizeof( Bucket ) == 8, "Bucket layout changed" );
+
+} // namespace WordTableFormat
+
+/*! \brief Read only view of a word table.
+ *
+ * The view does not own the data that it is set on, the owner of the data
+ * must keep it alive for the lifetime of the view. Since the view never
+ * changes the data, it can be queried from any number of threads at the
+ * same time without any locking. */
+class WordTable
+{
+public:
+  WordTable() = default;
+
+  /*! \brief Set the view on the given \a data.
+   *
+   * The data is validated before it is used.
+   * \param[in] data Start of the word table.
+   * \param[in] size Size of the data in bytes.
+   * \param[out] error Description of the problem if the data is not valid.
+   * \return True if the data is a valid word table. */
+  bool setData( const uchar* data, qint64 size, QString* error = nullptr );
+  /*! \brief Check if the view is set on valid data. */
+  bool isValid() const;
+  /*! \brief Check if the table contains the given UTF-8 encoded \a word. */
+  bool contains( QByteArrayView word ) const;
+  /*! \brief Check if the table contains the given \a word. */
+  bool contains( QStringView word ) const;
+  /*! \brief Number of words in the table. */
+  uint32_t wordCount() const;
+  /*! \brief Characters that should be tried when making suggestions for a word. */
+  QString tryCharacters() const;
+
+  /*! \brief Hash function used for the table, 64 bit FNV-1a. */
+  static uint64_t hash( QByteArrayView word );
+
+private:
+  const WordTableFormat::Bucket* d_buckets = nullptr;
+  const uchar* d_strings = nullptr;
+  uint32_t d_stringsSize = 0;
+  uint32_t d_mask        = 0;
+  uint32_t d_wordCount   = 0;
+  QString d_tryCharacters;
+};
+
+/*! \brief Builder for a word table.
+ *
+ * Words are collected using addWord() and the table is then created
+ * using build(). The result can be written to a file or used directly
+ * with a WordTable. */
+class WordTableBuilder
+{
+public:
+  /*! \brief Add a word to the table. Duplicates are ignored. */
+  void addWord( const QString& word );
+  /*! \brief Set the characters that should be tried when making suggestions. */
+  void setTryCharacters( const QString& characters );
+  /*! \brief Number of distinct words added. */
+  qsizetype wordCount() const;
+  /*! \brief Create the binary word table for all words that were added. */
+  QByteArray build() const;
+
+private:
+  QSet<QByteArray> d_words;
+  QString d_tryCharacters;
+};
+
+} // namespace CompiledDictionary
+} // namespace Checker
+} // namespace SpellChecker
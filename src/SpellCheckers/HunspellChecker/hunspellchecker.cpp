@@ -27,36 +27,82 @@
 #include <hunspell/hunspell.hxx>
 
 #include <coreplugin/icore.h>
+#include <utils/async.h>
 #include <utils/qtcsettings.h>
 
+#include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QFutureSynchronizer>
+#include <QLoggingCategory>
 #include <QMutex>
-#include <QSharedPointer>
 #include <QTextCodec>
 #include <QRegularExpression>
+#include <QThread>
+#include <QThreadPool>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
+
+/*! \brief Logging category for the loading of the dictionary, enable it with
+ * QT_LOGGING_RULES="qtc.spellchecker.hunspell.debug=true". */
+static Q_LOGGING_CATEGORY( hunspellLog, "qtc.spellchecker.hunspell", QtWarningMsg )
 
 namespace {
-/*! \brief Wrapper around Hunspell object */
+/*! \brief Wrapper around a pool of Hunspell objects.
+ *
+ * A single ::Hunspell object is not thread safe, and guarding one object
+ * with a single lock serialises all of the SpellCheckProcessor futures that
+ * run on the thread pool. Instead the wrapper keeps a small pool of
+ * independent Hunspell objects, all created from the same .dic/.aff pair.
+ * Each thread that uses the wrapper is assigned a slot in the pool and
+ * the Hunspell object for a slot is only created the first time that it
+ * is needed.
+ *
+ * Words added at runtime are kept in a list so that they can be replayed
+ * into each Hunspell object of the pool before it gets used again. */
 class HunspellWrapper
 {
+  /*! \brief A slot in the pool of Hunspell objects.
+   *
+   * The lock of a slot is normally only taken by one thread. It is still
+   * needed since more threads than slots can exist, in which case some
+   * threads will share a slot. */
+  struct Slot
+  {
+    using HunspellPtr = std::unique_ptr< ::Hunspell>;
+    QMutex mutex;
+    HunspellPtr hunspell;
+    int32_t replayedWords = 0; /*!< Number of words from the added words that
+                                * were already added to this object. */
+  };
+
 public:
-  /*! \brief Construct the wrapper and set up the hunspell object.
+  /*! \brief Construct the wrapper and set up the pool of hunspell objects.
    *
    * The dictionary name (full path and name) is needed to set up the
-   * hunspell object. From the supplied dictionary file, the associated
+   * hunspell objects. From the supplied dictionary file, the associated
    * .aff file is derived, which is also needed by Hunspell and must be
-   * co-located with the dictionary file. */
+   * co-located with the dictionary file.
+   *
+   * One slot is created for each thread that the global thread pool can run
+   * at the same time, with one extra for the main thread and one for the high
+   * priority thread used for the current editor. The first Hunspell object is
+   * created immediately to get the encoding of the dictionary. */
   HunspellWrapper( const QString& dictionary )
+    : d_affPath( QString( dictionary ).replace( QRegularExpression( "\\.dic$" ), ".aff" ).toLatin1() )
+    , d_dicPath( dictionary.toLatin1() )
+    , d_slots( std::max( QThreadPool::globalInstance()->maxThreadCount(), 1 ) + 2 )
+    , d_codec( nullptr )
   {
-    /* Get the affix dictionary path */
-    QString affPath = QString( dictionary ).replace( QRegularExpression("\\.dic$"), ".aff");
-    d_hunspell = HunspellPtr( new ::Hunspell( affPath.toLatin1(), dictionary.toLatin1() ) );
-    d_codec    = QTextCodec::codecForName( d_hunspell->get_dic_encoding() );
+    Slot& first    = d_slots.front();
+    first.hunspell = createHunspell();
+    d_codec        = QTextCodec::codecForName( first.hunspell->get_dic_encoding() );
   }
   /*! \brief Check if the supplied \a word is a spelling mistake or not.
    *
@@ -64,11 +110,30 @@ public:
    * object. */
   bool isSpellingMistake( const QString& word ) const
   {
-    QMutexLocker lock( &d_mutex );
-    HunspellPtr  hunspell = d_hunspell;
-    bool recognised       = hunspell->spell( encode( word ) );
+    Slot& slot = currentSlot();
+    QMutexLocker lock( &slot.mutex );
+    ::Hunspell& hunspell = prepareSlot( slot );
+    bool recognised      = hunspell.spell( encode( word ) );
     return ( recognised == false );
   }
+  /*! \brief Check a batch of words for spelling mistakes.
+   *
+   * The slot of the calling thread is only locked and prepared once for the
+   * whole batch and the same buffer is used to encode all of the words. */
+  void checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const
+  {
+    mistakes = QBitArray( words.size() );
+    std::string encoded;
+    Slot& slot = currentSlot();
+    QMutexLocker lock( &slot.mutex );
+    ::Hunspell& hunspell = prepareSlot( slot );
+    for( qsizetype index = 0; index < words.size(); ++index ) {
+      encodeInto( words.at( index ), encoded );
+      if( hunspell.spell( encoded ) == false ) {
+        mistakes.setBit( index );
+      }
+    }
+  }
   /*! \brief Get the list of suggestions for the given word.
    *
    * It is assumed that the \a word is a spelling mistake, thus
@@ -76,29 +141,76 @@ public:
   QStringList getSuggestionsForWord( const QString& word ) const
   {
     QStringList suggestionsList;
-    QMutexLocker lock( &d_mutex );
-    HunspellPtr  hunspell = d_hunspell;
-    std::vector<std::string> suggestions = d_hunspell->suggest( encode( word ) );
+    std::vector<std::string> suggestions;
+    {
+      Slot& slot = currentSlot();
+      QMutexLocker lock( &slot.mutex );
+      ::Hunspell& hunspell = prepareSlot( slot );
+      suggestions = hunspell.suggest( encode( word ) );
+    }
     suggestionsList.reserve( suggestions.size() );
     for ( const std::string& s : suggestions ) {
       suggestionsList << decode( s );
     }
     return suggestionsList;
   }
-  /*! \brief Add the given word to the Hunspell object.
+  /*! \brief Add the given word to the Hunspell objects.
    *
    * A word that is added will not be considered a spelling mistake.
    * Words added to the object will only be remembered for the lifetime
    * of the object. To remember a word between runs, external functionality
-   * must be used. */
+   * must be used.
+   *
+   * The word is not added to all objects in the pool immediately, it is
+   * added to the list of added words and each object will get the word
+   * the next time that it is used. */
   void addWord( const QString& word )
   {
-    QMutexLocker lock( &d_mutex );
-    HunspellPtr  hunspell = d_hunspell;
-    d_hunspell->add( encode( word ) );
+    QMutexLocker lock( &d_addedWordsMutex );
+    d_addedWords.push_back( encode( word ) );
+    d_addedWordsCount.store( static_cast<int32_t>( d_addedWords.size() ), std::memory_order_release );
   }
 
 private:
+  /*! \brief Create a new Hunspell object for the dictionary. */
+  Slot::HunspellPtr createHunspell() const
+  {
+    return std::make_unique< ::Hunspell>( d_affPath.constData(), d_dicPath.constData() );
+  }
+
+  /*! \brief Get the slot in the pool for the calling thread.
+   *
+   * Each thread gets a sequence number the first time that it uses any
+   * wrapper. The sequence number is then mapped onto the slots of the
+   * pool. Threads from the thread pool are long lived and are re-used,
+   * thus in practice each of them ends up with its own slot. */
+  Slot& currentSlot() const
+  {
+    static std::atomic<uint32_t> threadCounter{ 0 };
+    thread_local const uint32_t threadIndex = threadCounter.fetch_add( 1, std::memory_order_relaxed );
+    return d_slots[threadIndex % d_slots.size()];
+  }
+
+  /*! \brief Prepare the Hunspell object of the \a slot for use.
+   *
+   * Creates the Hunspell object if this is the first use of the slot and
+   * replays all words that were added since the slot was last used.
+   * The lock of the slot must be held by the caller. */
+  ::Hunspell& prepareSlot( Slot& slot ) const
+  {
+    if( slot.hunspell == nullptr ) {
+      slot.hunspell = createHunspell();
+    }
+    const int32_t addedCount = d_addedWordsCount.load( std::memory_order_acquire );
+    if( slot.replayedWords < addedCount ) {
+      QMutexLocker lock( &d_addedWordsMutex );
+      for( ; slot.replayedWords < static_cast<int32_t>( d_addedWords.size() ); ++slot.replayedWords ) {
+        slot.hunspell->add( d_addedWords.at( slot.replayedWords ) );
+      }
+    }
+    return *slot.hunspell;
+  }
+
   /*! \brief Encode a word into the encoding of the selected dictionary.
    *
    * If the selected dictionary uses a different encoding than the one
@@ -116,6 +228,23 @@ private:
     return word.toLatin1().toStdString();
   }
 
+  /*! \brief Encode a word into the supplied \a buffer.
+   *
+   * Same as encode(), but the buffer is re-used so that its memory does not
+   * need to be allocated again for each word of a batch. */
+  void encodeInto( QStringView word, std::string& buffer ) const
+  {
+    if( d_codec != nullptr ) {
+      const QByteArray encoded = d_codec->fromUnicode( word );
+      buffer.assign( encoded.constData(), encoded.size() );
+      return;
+    }
+    buffer.resize( word.size() );
+    for( qsizetype index = 0; index < word.size(); ++index ) {
+      buffer[index] = word.at( index ).toLatin1();
+    }
+  }
+
   /*! \brief Decode a word from the encoding of the selected dictionary.
    *
    * If the selected dictionary uses a different encoding than the one
@@ -133,10 +262,14 @@ private:
   }
 
 private:
-  using HunspellPtr = QSharedPointer< ::Hunspell>;
-  HunspellPtr d_hunspell;
+  const QByteArray d_affPath;
+  const QByteArray d_dicPath;
+  mutable std::vector<Slot> d_slots;
   QTextCodec* d_codec;
-  mutable QMutex d_mutex;
+  mutable QMutex d_addedWordsMutex;           /*!< Guards the d_addedWords. */
+  std::vector<std::string> d_addedWords;      /*!< Encoded words added at runtime. */
+  std::atomic<int32_t> d_addedWordsCount{ 0 }; /*!< Number of added words, used to check
+                                               * for new words without taking the lock. */
 };
 
 } // namespace
@@ -144,18 +277,52 @@ private:
 
 class SpellChecker::Checker::Hunspell::HunspellCheckerPrivate
 {
-  using HunspellWrapperPtr = std::unique_ptr<HunspellWrapper>;
 public:
+  using HunspellWrapperPtr = std::shared_ptr<HunspellWrapper>;
+
   QString dictionary;
   QString userDictionary;
   QMutex  fileMutex;
-  HunspellWrapperPtr hunspell;
+  QMutex  snapshotMutex;     /*!< Guards the hunspell pointer and the sessionWords. */
+  HunspellWrapperPtr hunspell; /*!< Current snapshot of the dictionary. */
+  QStringList sessionWords;  /*!< Words added or ignored during this session. They
+                              * are replayed into each new snapshot. */
+  std::atomic<uint32_t> generation{ 0 }; /*!< Generation of the latest requested
+                                          * snapshot. Older snapshots that finish
+                                          * loading after a newer one was requested
+                                          * are discarded. */
+  QFuture<void> loaded;      /*!< Finishes once the first snapshot was loaded. */
+  bool queriedWhileLoading = false; /*!< If a query on the main thread was answered
+                                     * without a snapshot. Guarded by the
+                                     * snapshotMutex. */
+  QFutureSynchronizer<void> loadFutures; /*!< All loads, to wait for them on destruction. */
 
   HunspellCheckerPrivate()
     : dictionary()
     , userDictionary()
   {}
   ~HunspellCheckerPrivate() {}
+
+  /*! \brief Get the current snapshot of the dictionary.
+   *
+   * If the first snapshot is still being loaded, a background thread waits
+   * for the loading to finish. The main thread must not block for the whole
+   * load, thus it gets a null snapshot instead and the files are checked
+   * again once the first snapshot was loaded. A caller keeps the snapshot
+   * that it got alive for as long as it needs it, even if a new snapshot gets
+   * published in between. */
+  HunspellWrapperPtr snapshot()
+  {
+    const bool mainThread = ( QThread::currentThread() == QCoreApplication::instance()->thread() );
+    if( mainThread == false ) {
+      loaded.waitForFinished();
+    }
+    QMutexLocker lock( &snapshotMutex );
+    if( hunspell == nullptr ) {
+      queriedWhileLoading = true;
+    }
+    return hunspell;
+  }
 };
 // --------------------------------------------------
 // --------------------------------------------------
@@ -168,13 +335,20 @@ HunspellChecker::HunspellChecker()
   , d( new HunspellCheckerPrivate() )
 {
   loadSettings();
-  d->hunspell = std::make_unique<HunspellWrapper>( d->dictionary );
-  loadUserAddedWords();
+  /* Loading a large dictionary and the user words can take a noticeable
+   * amount of time. This is done in the background so that the plugin does
+   * not slow down the start up of the application. Queries from background
+   * threads wait for the loading to finish before they use the dictionary,
+   * queries from the main thread do not find any mistakes until then. */
+  d->loaded = Utils::asyncRun( &HunspellChecker::loadDictionary, this, d->dictionary, d->userDictionary, d->generation.load() );
+  d->loadFutures.addFuture( d->loaded );
 }
 // --------------------------------------------------
 
 HunspellChecker::~HunspellChecker()
 {
+  stopBackgroundWork();
+  d->loadFutures.waitForFinished();
   /* Codec not deleted since the destructor of QTextCodec is private */
   // delete d->codec;
   saveSettings();
@@ -202,27 +376,80 @@ void HunspellChecker::loadSettings()
 }
 // --------------------------------------------------
 
-void HunspellChecker::loadUserAddedWords()
+void HunspellChecker::loadDictionary( const QString& dictionary, const QString& userDictionary, uint32_t generation )
 {
-  /* Save the word to the user dictionary */
-  if( d->userDictionary.isEmpty() == true ) {
+  QElapsedTimer timer;
+  timer.start();
+  HunspellCheckerPrivate::HunspellWrapperPtr wrapper = std::make_shared<HunspellWrapper>( dictionary );
+  const QStringList userWords = loadUserAddedWords( userDictionary );
+  for( const QString& word: userWords ) {
+    wrapper->addWord( word );
+  }
+
+  bool recheck = ( generation != 0 );
+  {
+    QMutexLocker lock( &d->snapshotMutex );
+    if( ( generation != d->generation.load() )
+        && ( d->hunspell != nullptr ) ) {
+      /* A newer dictionary was requested while this one was loading. The
+       * first snapshot is always published, since queries wait for it. */
+      qCDebug( hunspellLog ) << "Discarded out of date dictionary" << dictionary;
+      return;
+    }
+    /* Words that were added or ignored during the session must also be known
+     * by the new snapshot. Since they are added while holding the lock, no
+     * word can get lost between this and the publishing of the snapshot. */
+    for( const QString& word: std::as_const( d->sessionWords ) ) {
+      wrapper->addWord( word );
+    }
+    d->hunspell = wrapper;
+    recheck     = ( recheck == true ) || ( d->queriedWhileLoading == true );
+    d->queriedWhileLoading = false;
+  }
+  qCDebug( hunspellLog ) << "Loaded dictionary" << dictionary
+                         << "and" << userWords.size() << "user words in" << timer.elapsed() << "ms";
+
+  /* Before the first snapshot was loaded, only the main thread can get
+   * answers, and those are all "not a mistake". Thus the first snapshot only
+   * needs to invalidate the caches and recheck the files if the main thread
+   * asked something while it was loading, a reload always does. Jobs that
+   * are still busy on the old snapshot will finish on it, but their results
+   * will not end up in the caches. */
+  if( recheck == true ) {
+    invalidateCaches();
+    emit dictionaryReloaded();
+  }
+}
+// --------------------------------------------------
+
+void HunspellChecker::reloadDictionary()
+{
+  const uint32_t generation = ++d->generation;
+  d->loadFutures.addFuture( Utils::asyncRun( &HunspellChecker::loadDictionary, this, d->dictionary, d->userDictionary, generation ) );
+}
+// --------------------------------------------------
+
+QStringList HunspellChecker::loadUserAddedWords( const QString& userDictionary )
+{
+  QStringList words;
+  if( userDictionary.isEmpty() == true ) {
     qDebug() << "loadUserAddedWords: User dictionary name empty";
-    return;
+    return words;
   }
 
-  QFile dictionary( d->userDictionary );
+  QMutexLocker lock( &d->fileMutex );
+  QFile dictionary( userDictionary );
   if( dictionary.open( QIODevice::ReadOnly ) == false ) {
-    qDebug() << "loadUserAddedWords: Could not open user dictionary file: " << d->userDictionary;
-    return;
+    qDebug() << "loadUserAddedWords: Could not open user dictionary file: " << userDictionary;
+    return words;
   }
 
   QTextStream stream( &dictionary );
-  QString word;
   while( stream.atEnd() != true ) {
-    word = stream.readLine();
-    ignoreWord( word );
+    words << stream.readLine();
   }
   dictionary.close();
+  return words;
 }
 // --------------------------------------------------
 
@@ -243,19 +470,40 @@ void HunspellChecker::saveSettings() const
 
 bool HunspellChecker::isSpellingMistake( const QString& word ) const
 {
-  return d->hunspell->isSpellingMistake( word );
+  const HunspellCheckerPrivate::HunspellWrapperPtr hunspell = d->snapshot();
+  if( hunspell == nullptr ) {
+    /* Still loading, asked from the main thread. */
+    return false;
+  }
+  return hunspell->isSpellingMistake( word );
+}
+// --------------------------------------------------
+
+void HunspellChecker::checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const
+{
+  /* The snapshot is kept for the whole batch. */
+  const HunspellCheckerPrivate::HunspellWrapperPtr hunspell = d->snapshot();
+  if( hunspell == nullptr ) {
+    mistakes = QBitArray( words.size() );
+    return;
+  }
+  hunspell->checkWords( words, mistakes );
 }
 // --------------------------------------------------
 
 void HunspellChecker::getSuggestionsForWord( const QString& word, QStringList& suggestionsList ) const
 {
-  suggestionsList = d->hunspell->getSuggestionsForWord( word );
+  const HunspellCheckerPrivate::HunspellWrapperPtr hunspell = d->snapshot();
+  if( hunspell == nullptr ) {
+    suggestionsList.clear();
+    return;
+  }
+  suggestionsList = hunspell->getSuggestionsForWord( word );
 }
 // --------------------------------------------------
 
 bool HunspellChecker::addWord( const QString& word )
 {
-  // HunspellPtr  hunspell = d->hunspell;*/
   /* Save the word to the user dictionary */
   if( d->userDictionary.isEmpty() == true ) {
     qDebug() << "User dictionary name empty";
@@ -270,7 +518,7 @@ bool HunspellChecker::addWord( const QString& word )
     return false;
   }
   /* Only add the word to the spellchecker if the previous checks passed. */
-  d->hunspell->addWord( word );
+  addSessionWord( word );
 
   QTextStream stream( &dictionary );
   stream << word << Qt::endl;
@@ -283,11 +531,26 @@ bool HunspellChecker::ignoreWord( const QString& word )
 {
   /* The word is only added for this run of the IDE.
    * For this reason it is not added to the file. */
-  d->hunspell->addWord( word );
+  addSessionWord( word );
   return true;
 }
 // --------------------------------------------------
 
+void HunspellChecker::addSessionWord( const QString& word )
+{
+  {
+    QMutexLocker lock( &d->snapshotMutex );
+    d->sessionWords.append( word );
+    /* If the first snapshot is still loading, the word gets added to it
+     * when it gets published. */
+    if( d->hunspell != nullptr ) {
+      d->hunspell->addWord( word );
+    }
+  }
+  invalidateCaches();
+}
+// --------------------------------------------------
+
 SpellChecker::IOptionsWidget* HunspellChecker::optionsWidget()
 {
   HunspellOptionsWidget* widget = new HunspellOptionsWidget( d->dictionary, d->userDictionary );
@@ -304,6 +567,8 @@ void HunspellChecker::updateDictionary( const QString& dictionary )
   if( d->dictionary != dictionary ) {
     d->dictionary = dictionary;
     emit dictionaryChanged( d->dictionary );
+    /* The current snapshot stays in use until the new dictionary is loaded. */
+    reloadDictionary();
   }
 }
 // --------------------------------------------------
@@ -313,6 +578,7 @@ void HunspellChecker::updateUserDictionary( const QString& userDictionary )
   if( d->userDictionary != userDictionary ) {
     d->userDictionary = userDictionary;
     emit userDictionaryChanged( d->userDictionary );
+    reloadDictionary();
   }
 }
 // --------------------------------------------------
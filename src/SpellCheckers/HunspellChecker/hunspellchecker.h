@@ -39,6 +39,7 @@ public:
 
   QString name() const Q_DECL_OVERRIDE;
   bool isSpellingMistake( const QString& word ) const Q_DECL_OVERRIDE;
+  void checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const Q_DECL_OVERRIDE;
   void getSuggestionsForWord( const QString& word, QStringList& suggestionsList ) const Q_DECL_OVERRIDE;
   bool addWord( const QString& word ) Q_DECL_OVERRIDE;
   bool ignoreWord( const QString& word ) Q_DECL_OVERRIDE;
@@ -55,7 +56,20 @@ public slots:
 private:
   void loadSettings();
   void saveSettings() const;
-  void loadUserAddedWords();
+  /*! \brief Load the \a dictionary and the words from the \a userDictionary.
+   *
+   * This function runs in the background and logs the time that it took to
+   * load the dictionary to the "qtc.spellchecker.hunspell" category. The loaded dictionary is published as the new
+   * snapshot that will be used, unless a newer \a generation was requested
+   * while it was loading. */
+  void loadDictionary( const QString& dictionary, const QString& userDictionary, uint32_t generation );
+  /*! \brief Start loading a new snapshot of the current dictionaries in the background. */
+  void reloadDictionary();
+  /*! \brief Add a word to the current snapshot and to all snapshots that get
+   * loaded during this session. */
+  void addSessionWord( const QString& word );
+  /*! \brief Read the words that the user added to the \a userDictionary. */
+  QStringList loadUserAddedWords( const QString& userDictionary );
   HunspellCheckerPrivate* const d;
 };
 
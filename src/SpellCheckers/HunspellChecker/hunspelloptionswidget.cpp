@@ -94,9 +94,6 @@ void HunspellOptionsWidget::apply()
 
 void HunspellOptionsWidget::updateDictionary( const QString& dictionary )
 {
-  if( dictionary != ui->lineEditDictionary->text() ) {
-    emit optionsError( QLatin1String( "Hunspell Spellchecker" ), tr( "Application restart needed for changes to take affect." ) );
-  }
   ui->lineEditDictionary->setText( dictionary );
   /* If the dictionary gets changed, and the user dictionary is empty
    * Create a self generated user dictionary name derived from the
@@ -117,9 +114,6 @@ void HunspellOptionsWidget::updateDictionary( const QString& dictionary )
 
 void HunspellOptionsWidget::updateUserDictionary( const QString& userDictionary )
 {
-  if( userDictionary != ui->lineEditDictionary->text() ) {
-    emit optionsError( QLatin1String( "Hunspell Spellchecker" ), tr( "Application restart needed for changes to take affect." ) );
-  }
   ui->lineEditUserDictionary->setText( userDictionary );
 }
 // --------------------------------------------------
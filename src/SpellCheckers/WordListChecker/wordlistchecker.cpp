@@ -0,0 +1,439 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "wordlistchecker.h"
+#include "wordlistoptionswidget.h"
+#include "WordListConstants.h"
+
+#include "../CompiledDictionaryChecker/wordlookup.h"
+#include "../CompiledDictionaryChecker/wordtable.h"
+#include "../../spellcheckerconstants.h"
+
+#include <coreplugin/icore.h>
+#include <utils/async.h>
+#include <utils/qtcsettings.h>
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureSynchronizer>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QSet>
+#include <QTextStream>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/*! \brief Logging category for the loading of the word lists, enable it with
+ * QT_LOGGING_RULES="qtc.spellchecker.wordlist.debug=true". */
+static Q_LOGGING_CATEGORY( wordListLog, "qtc.spellchecker.wordlist", QtWarningMsg )
+
+namespace {
+using SpellChecker::Checker::CompiledDictionary::WordTable;
+using SpellChecker::Checker::CompiledDictionary::WordTableBuilder;
+
+/*! \brief A built word table along with the data that it is a view on. */
+struct Table
+{
+  QByteArray data;
+  WordTable table;
+};
+
+/*! \brief Immutable snapshot of all words known by the checker.
+ *
+ * The table is shared between the snapshots that only differ in the words
+ * that were added during the session. */
+struct Snapshot
+{
+  std::shared_ptr<const Table> table;
+  QSet<QString> sessionWords;
+
+  /*! \brief Check if the \a word is known, using the case rules of Hunspell. */
+  bool isKnown( QStringView word ) const
+  {
+    using SpellChecker::Checker::CompiledDictionary::containsWithCaseRules;
+    return containsWithCaseRules( word, [this]( QStringView exactWord ) {
+      if( table->table.contains( exactWord ) == true ) {
+        return true;
+      }
+      return ( ( sessionWords.isEmpty() == false )
+               && ( sessionWords.contains( exactWord.toString() ) == true ) );
+    } );
+  }
+};
+
+/*! \brief Add the words of the plain word list \a fileName to the \a builder.
+ *
+ * The file contains one word per line, empty lines and lines that start
+ * with a '#' are skipped.
+ * \return Number of lines that were read, or -1 if the file could not be opened. */
+qsizetype readWordList( const QString& fileName, WordTableBuilder& builder )
+{
+  QFile file( fileName );
+  if( file.open( QIODevice::ReadOnly | QIODevice::Text ) == false ) {
+    return -1;
+  }
+  QTextStream stream( &file );
+  qsizetype lines = 0;
+  QString line;
+  while( stream.readLineInto( &line ) == true ) {
+    ++lines;
+    const QStringView word = QStringView( line ).trimmed();
+    if( ( word.isEmpty() == false )
+        && ( word.startsWith( QLatin1Char( '#' ) ) == false ) ) {
+      builder.addWord( word.toString() );
+    }
+  }
+  return lines;
+}
+// --------------------------------------------------
+} // namespace
+
+class SpellChecker::Checker::WordList::WordListCheckerPrivate
+{
+public:
+  QStringList wordLists;
+  QString userDictionary;
+  QMutex  fileMutex;
+  QMutex  publishMutex;             /*!< Serialises the publishing of snapshots, readers
+                                     * never take it. Also guards the sessionWords,
+                                     * the published and the retired snapshots. */
+  std::atomic<const Snapshot*> current{ nullptr }; /*!< Current snapshot. */
+  std::atomic<int> readers{ 0 };    /*!< Number of queries that use a snapshot. */
+  std::atomic<bool> hasRetired{ false }; /*!< True if there are retired snapshots. */
+  std::unique_ptr<const Snapshot> published; /*!< Owns the current snapshot. */
+  std::vector<std::unique_ptr<const Snapshot>> retired; /*!< Replaced snapshots that
+                                                         * might still be in use. */
+  QSet<QString> sessionWords;       /*!< Words added or ignored during this session. */
+  std::atomic<uint32_t> generation{ 0 }; /*!< Generation of the latest requested table. */
+  QFuture<void> loaded;             /*!< Finishes once the first snapshot was published. */
+  QFutureSynchronizer<void> loadFutures; /*!< All loads, to wait for them on destruction. */
+
+  /*! \brief Access to the current snapshot for the duration of a query.
+   *
+   * Only while the first snapshot is still loading this waits for it, after
+   * that it is a single atomic load. The snapshot stays valid for the
+   * lifetime of the reader, even if a new snapshot gets published. */
+  class Reader
+  {
+  public:
+    explicit Reader( WordListCheckerPrivate* d )
+      : d_d( d )
+    {
+      /* The count is raised before the pointer is loaded. A publisher that
+       * sees no readers after storing a new snapshot knows that nobody can
+       * still load one of the retired snapshots. */
+      d_d->readers.fetch_add( 1 );
+      d_snapshot = d_d->current.load();
+      if( d_snapshot == nullptr ) {
+        d_d->loaded.waitForFinished();
+        d_snapshot = d_d->current.load();
+      }
+    }
+    ~Reader()
+    {
+      if( ( d_d->readers.fetch_sub( 1 ) == 1 )
+          && ( d_d->hasRetired.load() == true )
+          && ( d_d->publishMutex.tryLock() == true ) ) {
+        d_d->reclaim();
+        d_d->publishMutex.unlock();
+      }
+    }
+    Reader( const Reader& ) = delete;
+    Reader& operator=( const Reader& ) = delete;
+
+    const Snapshot* operator->() const
+    {
+      return d_snapshot;
+    }
+    const Snapshot* get() const
+    {
+      return d_snapshot;
+    }
+
+  private:
+    WordListCheckerPrivate* d_d;
+    const Snapshot* d_snapshot = nullptr;
+  };
+
+  /*! \brief Publish the \a snapshot as the current snapshot.
+   *
+   * The caller must hold the publishMutex. The previous snapshot is retired,
+   * it is deleted as soon as no query uses a snapshot anymore. */
+  void publish( std::unique_ptr<Snapshot> snapshot )
+  {
+    current.store( snapshot.get() );
+    if( published != nullptr ) {
+      retired.push_back( std::move( published ) );
+      hasRetired.store( true );
+    }
+    published = std::move( snapshot );
+    reclaim();
+  }
+
+  /*! \brief Delete the retired snapshots if no query uses a snapshot.
+   *
+   * The caller must hold the publishMutex. A query that starts after the
+   * check can only get the current snapshot, which is never retired. */
+  void reclaim()
+  {
+    if( ( retired.empty() == false )
+        && ( readers.load() == 0 ) ) {
+      retired.clear();
+      hasRetired.store( false );
+    }
+  }
+};
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+using namespace SpellChecker::Checker::WordList;
+namespace WordListConstants = SpellChecker::SpellCheckers::WordListChecker::Constants;
+
+WordListChecker::WordListChecker()
+  : ISpellChecker()
+  , d( new WordListCheckerPrivate() )
+{
+  loadSettings();
+  /* Large generated word lists take a while to load, this is done in the
+   * background to not slow down the start up of the application. */
+  d->loaded = Utils::asyncRun( &WordListChecker::loadWordLists, this, d->wordLists, d->userDictionary, d->generation.load() );
+  d->loadFutures.addFuture( d->loaded );
+}
+// --------------------------------------------------
+
+WordListChecker::~WordListChecker()
+{
+  stopBackgroundWork();
+  d->loadFutures.waitForFinished();
+  saveSettings();
+  delete d;
+}
+// --------------------------------------------------
+
+QString WordListChecker::name() const
+{
+  return tr( "Word List" );
+}
+// --------------------------------------------------
+
+void WordListChecker::loadSettings()
+{
+  Utils::QtcSettings* settings = Core::ICore::settings();
+  settings->beginGroup( Constants::CORE_SETTINGS_GROUP );
+  settings->beginGroup( Constants::CORE_SPELLCHECKERS_GROUP );
+  settings->beginGroup( WordListConstants::SETTINGS_GROUP );
+  d->wordLists      = settings->value( WordListConstants::SETTING_WORD_LISTS, QStringList() ).toStringList();
+  d->userDictionary = settings->value( WordListConstants::SETTING_USER_DICTIONARY, QLatin1String( "" ) ).toString();
+  settings->endGroup();
+  settings->endGroup();
+  settings->endGroup();
+}
+// --------------------------------------------------
+
+void WordListChecker::saveSettings() const
+{
+  Utils::QtcSettings* settings = Core::ICore::settings();
+  settings->beginGroup( Constants::CORE_SETTINGS_GROUP );
+  settings->beginGroup( Constants::CORE_SPELLCHECKERS_GROUP );
+  settings->beginGroup( WordListConstants::SETTINGS_GROUP );
+  settings->setValue( WordListConstants::SETTING_WORD_LISTS,      d->wordLists );
+  settings->setValue( WordListConstants::SETTING_USER_DICTIONARY, d->userDictionary );
+  settings->endGroup();
+  settings->endGroup();
+  settings->endGroup();
+  settings->sync();
+}
+// --------------------------------------------------
+
+void WordListChecker::loadWordLists( const QStringList& wordLists, const QString& userDictionary, uint32_t generation )
+{
+  QElapsedTimer timer;
+  timer.start();
+  WordTableBuilder builder;
+  for( const QString& wordList: wordLists ) {
+    if( readWordList( wordList, builder ) == -1 ) {
+      qDebug() << "WordList: Could not open word list" << wordList;
+    }
+  }
+  if( userDictionary.isEmpty() == false ) {
+    QMutexLocker lock( &d->fileMutex );
+    readWordList( userDictionary, builder );
+  }
+
+  auto table  = std::make_shared<Table>();
+  table->data = builder.build();
+  QString error;
+  if( table->table.setData( reinterpret_cast<const uchar*>( table->data.constData() ), table->data.size(), &error ) == false ) {
+    /* This would be a bug in the builder, an empty table is still used so
+     * that queries do not have to check for it. */
+    qDebug() << "WordList: Built table not valid:" << error;
+  }
+
+  {
+    QMutexLocker lock( &d->publishMutex );
+    if( ( generation != d->generation.load() )
+        && ( d->current.load() != nullptr ) ) {
+      /* A newer table was requested while this one was loading. The first
+       * snapshot is always published, since queries wait for it. */
+      qCDebug( wordListLog ) << "Discarded out of date word lists" << wordLists;
+      return;
+    }
+    auto snapshot          = std::make_unique<Snapshot>();
+    snapshot->table        = table;
+    snapshot->sessionWords = d->sessionWords;
+    d->publish( std::move( snapshot ) );
+  }
+  qCDebug( wordListLog ) << "Loaded" << builder.wordCount() << "words from"
+                         << wordLists.size() << "word lists in" << timer.elapsed() << "ms";
+
+  if( generation != 0 ) {
+    invalidateCaches();
+    emit dictionaryReloaded();
+  }
+}
+// --------------------------------------------------
+
+void WordListChecker::reloadWordLists()
+{
+  const uint32_t generation = ++d->generation;
+  d->loadFutures.addFuture( Utils::asyncRun( &WordListChecker::loadWordLists, this, d->wordLists, d->userDictionary, generation ) );
+}
+// --------------------------------------------------
+
+bool WordListChecker::isSpellingMistake( const QString& word ) const
+{
+  const WordListCheckerPrivate::Reader snapshot( d );
+  return ( snapshot->isKnown( word ) == false );
+}
+// --------------------------------------------------
+
+void WordListChecker::checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const
+{
+  mistakes = QBitArray( words.size() );
+  const WordListCheckerPrivate::Reader snapshot( d );
+  for( qsizetype index = 0; index < words.size(); ++index ) {
+    if( snapshot->isKnown( words.at( index ) ) == false ) {
+      mistakes.setBit( index );
+    }
+  }
+}
+// --------------------------------------------------
+
+void WordListChecker::getSuggestionsForWord( const QString& word, QStringList& suggestionsList ) const
+{
+  using namespace SpellChecker::Checker::CompiledDictionary;
+  const WordListCheckerPrivate::Reader snapshot( d );
+  suggestionsList = makeSuggestions( word, DEFAULT_TRY_CHARACTERS, [&snapshot]( const QString& candidate ) {
+    return snapshot->isKnown( candidate );
+  }, WordListConstants::MAX_SUGGESTIONS );
+}
+// --------------------------------------------------
+
+bool WordListChecker::addWord( const QString& word )
+{
+  /* Save the word to the user dictionary */
+  if( d->userDictionary.isEmpty() == true ) {
+    qDebug() << "User dictionary name empty";
+    return false;
+  }
+
+  QMutexLocker lock( &d->fileMutex );
+  QFileInfo( d->userDictionary ).dir().mkpath( "." );
+  QFile dictionary( d->userDictionary );
+  if( dictionary.open( QIODevice::Append ) == false ) {
+    qDebug() << "Could not open user dictionary file: " << d->userDictionary;
+    return false;
+  }
+  /* Only add the word to the spellchecker if the previous checks passed. */
+  addSessionWord( word );
+
+  QTextStream stream( &dictionary );
+  stream << word << Qt::endl;
+  dictionary.close();
+  return true;
+}
+// --------------------------------------------------
+
+bool WordListChecker::ignoreWord( const QString& word )
+{
+  /* The word is only added for this run of the IDE.
+   * For this reason it is not added to the file. */
+  addSessionWord( word );
+  return true;
+}
+// --------------------------------------------------
+
+void WordListChecker::addSessionWord( const QString& word )
+{
+  {
+    QMutexLocker lock( &d->publishMutex );
+    d->sessionWords.insert( word );
+    /* The table of the current snapshot is re-used, only the session words
+     * are copied. If the first snapshot is still loading, the word gets
+     * added to it when it gets published. */
+    const Snapshot* current = d->current.load();
+    if( current != nullptr ) {
+      auto snapshot          = std::make_unique<Snapshot>();
+      snapshot->table        = current->table;
+      snapshot->sessionWords = d->sessionWords;
+      d->publish( std::move( snapshot ) );
+    }
+  }
+  invalidateCaches();
+}
+// --------------------------------------------------
+
+SpellChecker::IOptionsWidget* WordListChecker::optionsWidget()
+{
+  WordListOptionsWidget* widget = new WordListOptionsWidget( d->wordLists, d->userDictionary );
+  connect( this,   &WordListChecker::wordListsChanged,            widget, &WordListOptionsWidget::updateWordLists );
+  connect( this,   &WordListChecker::userDictionaryChanged,       widget, &WordListOptionsWidget::updateUserDictionary );
+  connect( widget, &WordListOptionsWidget::wordListsChanged,      this,   &WordListChecker::updateWordLists );
+  connect( widget, &WordListOptionsWidget::userDictionaryChanged, this,   &WordListChecker::updateUserDictionary );
+  return widget;
+}
+// --------------------------------------------------
+
+void WordListChecker::updateWordLists( const QStringList& wordLists )
+{
+  if( d->wordLists != wordLists ) {
+    d->wordLists = wordLists;
+    emit wordListsChanged( d->wordLists );
+    /* The current snapshot stays in use until the new table is loaded. */
+    reloadWordLists();
+  }
+}
+// --------------------------------------------------
+
+void WordListChecker::updateUserDictionary( const QString& userDictionary )
+{
+  if( d->userDictionary != userDictionary ) {
+    d->userDictionary = userDictionary;
+    emit userDictionaryChanged( d->userDictionary );
+    reloadWordLists();
+  }
+}
+// --------------------------------------------------
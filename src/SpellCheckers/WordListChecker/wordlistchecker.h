@@ -0,0 +1,86 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "../../ISpellChecker.h"
+
+#include <QObject>
+
+namespace SpellChecker {
+namespace Checker {
+namespace WordList {
+
+class WordListCheckerPrivate;
+/*! \brief Spell checker that only knows the words of plain word lists.
+ *
+ * This checker does not know any affix rules, a word is only correct if it
+ * is in one of the word lists, one word per line, or if it was added by the
+ * user. This is useful to check text against an approved vocabulary, which
+ * can be large and generated.
+ *
+ * The words are loaded into a flat open addressing hash table that is
+ * published as an immutable snapshot. Queries only load the pointer to the
+ * current snapshot and never take a lock, thus any number of threads can
+ * check words at the same time. Queries are counted, a replaced snapshot is
+ * deleted once no query uses a snapshot anymore. */
+class WordListChecker
+  : public SpellChecker::ISpellChecker
+{
+  Q_OBJECT
+public:
+  WordListChecker();
+  ~WordListChecker() override;
+
+  QString name() const Q_DECL_OVERRIDE;
+  bool isSpellingMistake( const QString& word ) const Q_DECL_OVERRIDE;
+  void checkWords( const QVector<QStringView>& words, QBitArray& mistakes ) const Q_DECL_OVERRIDE;
+  void getSuggestionsForWord( const QString& word, QStringList& suggestionsList ) const Q_DECL_OVERRIDE;
+  bool addWord( const QString& word ) Q_DECL_OVERRIDE;
+  bool ignoreWord( const QString& word ) Q_DECL_OVERRIDE;
+  IOptionsWidget* optionsWidget() Q_DECL_OVERRIDE;
+
+signals:
+  void wordListsChanged( const QStringList& wordLists );
+  void userDictionaryChanged( const QString& userDictionary );
+
+public slots:
+  void updateWordLists( const QStringList& wordLists );
+  void updateUserDictionary( const QString& userDictionary );
+
+private:
+  void loadSettings();
+  void saveSettings() const;
+  /*! \brief Build the table for the \a wordLists and the \a userDictionary.
+   *
+   * This function runs in the background. The table is published as the new
+   * snapshot, unless a newer \a generation was requested while it was loading. */
+  void loadWordLists( const QStringList& wordLists, const QString& userDictionary, uint32_t generation );
+  /*! \brief Start loading a new table for the current word lists in the background. */
+  void reloadWordLists();
+  /*! \brief Add a word to the current snapshot and to all snapshots that get
+   * loaded during this session. */
+  void addSessionWord( const QString& word );
+  WordListCheckerPrivate* const d;
+};
+
+} // namespace WordList
+} // namespace Checker
+} // namespace SpellChecker
@@ -0,0 +1,147 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "wordlistoptionswidget.h"
+#include "ui_wordlistoptionswidget.h"
+
+#include <coreplugin/icore.h>
+
+#include <QFileDialog>
+
+using namespace SpellChecker::Checker::WordList;
+
+WordListOptionsWidget::WordListOptionsWidget( const QStringList& wordLists, const QString& userDictionary, QWidget* parent )
+  : IOptionsWidget()
+  , ui( new Ui::WordListOptionsWidget )
+{
+  ui->setupUi( this );
+  connect( ui->toolButtonAddWordList,          &QToolButton::clicked, this, &WordListOptionsWidget::toolButtonAddWordListClicked );
+  connect( ui->toolButtonRemoveWordList,       &QToolButton::clicked, this, &WordListOptionsWidget::toolButtonRemoveWordListClicked );
+  connect( ui->toolButtonBrowseUserDictionary, &QToolButton::clicked, this, &WordListOptionsWidget::toolButtonBrowseUserDictionaryClicked );
+
+  /* Set the hints on the different Dictionaries */
+  ui->listWidgetWordLists->setToolTip( tr( "Plain text files with one word per line. Only words in these lists \n"
+                                           "and in the user dictionary are considered to be spelled correctly. \n"
+                                           "Empty lines and lines starting with a '#' are ignored." ) );
+  ui->lineEditUserDictionary->setToolTip( tr( "The User Dictionary is a custom user dictionary that the spellchecker \n"
+                                              "will use to remember words that get added to the dictionary. \n"
+                                              "If such a file does not already exist, it will get created with the given information. " ) );
+
+  updateWordLists( wordLists );
+  updateUserDictionary( userDictionary );
+  if( userDictionary.isEmpty() == true ) {
+    updateUserDictionary( Core::ICore::userResourcePath().toString() + QLatin1String( "/UserDictionaries/QtC-WordList.udic" ) );
+  }
+}
+// --------------------------------------------------
+
+WordListOptionsWidget::~WordListOptionsWidget()
+{
+  delete ui;
+}
+// --------------------------------------------------
+
+void WordListOptionsWidget::apply()
+{
+  /* Make sure the word lists exist */
+  const QStringList lists = wordLists();
+  for( const QString& wordList: lists ) {
+    if( QFileInfo::exists( wordList ) == false ) {
+      emit optionsError( QLatin1String( "Word List Spellchecker" ), tr( "Word list does not exist: %1" ).arg( wordList ) );
+      return;
+    }
+  }
+  emit wordListsChanged( lists );
+
+  QFileInfo userDict( ui->lineEditUserDictionary->text() );
+  if( userDict.dir().mkpath( "." ) == false ) {
+    emit optionsError( QLatin1String( "Word List Spellchecker" ), tr( "Path to user dictionary could not be created" ) );
+    return;
+  }
+  /* The Dir should exist at this point, check if the file exists and can be made if it does not */
+  if( userDict.exists() == false ) {
+    QFile file( ui->lineEditUserDictionary->text() );
+    if( file.open( QFile::ReadWrite | QFile::Text ) == false ) {
+      emit optionsError( QLatin1String( "Word List Spellchecker" ), tr( "User dictionary can not be created, perhaps insufficient access on folder." ) );
+      return;
+    }
+  }
+  /* At this point the user dictionary specified should be valid. */
+  emit userDictionaryChanged( ui->lineEditUserDictionary->text() );
+}
+// --------------------------------------------------
+
+void WordListOptionsWidget::updateWordLists( const QStringList& wordLists )
+{
+  ui->listWidgetWordLists->clear();
+  ui->listWidgetWordLists->addItems( wordLists );
+}
+// --------------------------------------------------
+
+void WordListOptionsWidget::updateUserDictionary( const QString& userDictionary )
+{
+  ui->lineEditUserDictionary->setText( userDictionary );
+}
+// --------------------------------------------------
+
+QStringList WordListOptionsWidget::wordLists() const
+{
+  QStringList lists;
+  for( int row = 0; row < ui->listWidgetWordLists->count(); ++row ) {
+    lists << ui->listWidgetWordLists->item( row )->text();
+  }
+  return lists;
+}
+// --------------------------------------------------
+
+void WordListOptionsWidget::toolButtonAddWordListClicked()
+{
+  const QStringList files = QFileDialog::getOpenFileNames( this,
+                                                           tr( "Word List Files" ),
+                                                           QString(),
+                                                           tr( "Word Lists (*.txt *.dic *.udic);;All Files (*)" ),
+                                                           0,
+                                                           QFileDialog::ReadOnly );
+  const QStringList current = wordLists();
+  for( const QString& file: files ) {
+    if( current.contains( file ) == false ) {
+      ui->listWidgetWordLists->addItem( file );
+    }
+  }
+}
+// --------------------------------------------------
+
+void WordListOptionsWidget::toolButtonRemoveWordListClicked()
+{
+  delete ui->listWidgetWordLists->currentItem();
+}
+// --------------------------------------------------
+
+void WordListOptionsWidget::toolButtonBrowseUserDictionaryClicked()
+{
+  QString userDictionary = QFileDialog::getSaveFileName( this,
+                                                         tr( "User Dictionary File" ),
+                                                         ui->lineEditUserDictionary->text(),
+                                                         tr( "Dictionaries (*.udic)" ));
+  if( userDictionary.isEmpty() == false ) {
+    updateUserDictionary( userDictionary );
+  }
+}
+// --------------------------------------------------
@@ -0,0 +1,113 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "StringInterner.h"
+
+using namespace SpellChecker;
+
+StringInterner::Id StringInterner::intern( const QString& string )
+{
+  {
+    QReadLocker locker( &d_lock );
+    const auto iter = d_ids.constFind( string );
+    if( iter != d_ids.constEnd() ) {
+      return iter.value();
+    }
+  }
+  QWriteLocker locker( &d_lock );
+  /* Another thread could have added the string in between the locks. */
+  const auto iter = d_ids.constFind( string );
+  if( iter != d_ids.constEnd() ) {
+    return iter.value();
+  }
+  Id id;
+  if( d_freeIds.isEmpty() == false ) {
+    id            = d_freeIds.takeLast();
+    d_strings[id] = string;
+  } else {
+    id = Id( d_strings.size() );
+    d_strings.append( string );
+  }
+  d_ids.insert( string, id );
+  return id;
+}
+// --------------------------------------------------
+
+StringInterner::Id StringInterner::find( const QString& string ) const
+{
+  QReadLocker locker( &d_lock );
+  return d_ids.value( string, INVALID_ID );
+}
+// --------------------------------------------------
+
+QString StringInterner::string( Id id ) const
+{
+  QReadLocker locker( &d_lock );
+  if( id >= Id( d_strings.size() ) ) {
+    Q_ASSERT( id < Id( d_strings.size() ) );
+    return QString();
+  }
+  return d_strings.at( id );
+}
+// --------------------------------------------------
+
+int32_t StringInterner::count() const
+{
+  QReadLocker locker( &d_lock );
+  return int32_t( d_ids.size() );
+}
+// --------------------------------------------------
+
+void StringInterner::compact( const QSet<Id>& idsInUse )
+{
+  QWriteLocker locker( &d_lock );
+  if( idsInUse.isEmpty() == true ) {
+    /* Nothing is used anymore, start over with an empty table. */
+    d_ids.clear();
+    d_strings.clear();
+    d_freeIds.clear();
+    return;
+  }
+  for( auto iter = d_ids.begin(); iter != d_ids.end(); ) {
+    if( idsInUse.contains( iter.value() ) == true ) {
+      ++iter;
+      continue;
+    }
+    d_strings[iter.value()] = QString();
+    d_freeIds.append( iter.value() );
+    iter = d_ids.erase( iter );
+  }
+  d_ids.squeeze();
+}
+// --------------------------------------------------
+
+StringInterner& StringInterner::words()
+{
+  static StringInterner interner;
+  return interner;
+}
+// --------------------------------------------------
+
+StringInterner& StringInterner::files()
+{
+  static StringInterner interner;
+  return interner;
+}
+// --------------------------------------------------
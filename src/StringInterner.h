@@ -0,0 +1,95 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+namespace SpellChecker {
+
+/*! \brief The StringInterner class
+ *
+ * Table that maps a string to a small integer id, and back. Each distinct
+ * string is only stored once, no matter how many times it gets interned.
+ * Records that are stored in large numbers, like the spelling mistakes of
+ * a project, keep the id instead of their own copy of the string.
+ *
+ * An id stays valid until the table is compacted. Records come and go with
+ * the files and the projects, thus the strings that are no longer used are
+ * removed with compact() once the records that used them were cleared, and
+ * their ids are reused for new strings.
+ *
+ * The table is thread safe, strings are interned from the threads that spell
+ * check files and looked up from the main thread. */
+class StringInterner
+{
+  /*! \brief Deleted copy constructor */
+  StringInterner( const StringInterner& ) = delete;
+  /*! \brief Deleted assignment operator */
+  StringInterner& operator=( const StringInterner& ) = delete;
+
+public:
+  /*! \brief Alias for the id of a string. */
+  using Id = uint32_t;
+  /*! \brief Id returned by find() if the string was never interned. */
+  static constexpr Id INVALID_ID = UINT32_MAX;
+
+  StringInterner() = default;
+
+  /*! \brief Get the id of the \a string, adding it to the table if it is
+   * not in the table yet. */
+  Id intern( const QString& string );
+  /*! \brief Get the id of the \a string without adding it.
+   * \return The id, or INVALID_ID if the string was never interned. */
+  Id find( const QString& string ) const;
+  /*! \brief Get the string for the given \a id.
+   *
+   * The string is implicitly shared with the table, it is not copied. */
+  QString string( Id id ) const;
+  /*! \brief Get the number of strings in the table. */
+  int32_t count() const;
+  /*! \brief Remove all strings from the table, except the ones in use.
+   *
+   * The ids of the removed strings are reused for strings that get interned
+   * later. The caller must make sure that no records with other ids exist
+   * anymore, and that no strings get interned while the table is compacted.
+   * \param[in] idsInUse Ids of the strings that are still used, these ids
+   *              stay valid. */
+  void compact( const QSet<Id>& idsInUse );
+
+  /*! \brief Global table for the text of words. */
+  static StringInterner& words();
+  /*! \brief Global table for the names of files. */
+  static StringInterner& files();
+
+private:
+  mutable QReadWriteLock d_lock;
+  QHash<QString, Id> d_ids;
+  QVector<QString> d_strings;
+  QVector<Id> d_freeIds; /*!< Ids of removed strings, reused by intern(). */
+};
+
+} // namespace SpellChecker
@@ -0,0 +1,215 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "ISpellChecker.h"
+#include "SuggestionService.h"
+
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+/*! \brief Priority of a word that a caller is waiting for. */
+constexpr int PRIORITY_REQUESTED = 1;
+/*! \brief Priority of a word that is retried in the background. */
+constexpr int PRIORITY_RETRY = 0;
+/*! \brief Maximum number of entries in each stripe of the suggestions cache. */
+constexpr int32_t CACHE_ENTRIES_PER_STRIPE = 256;
+
+/*! \brief State of a word that suggestions are being retrieved for.
+ *
+ * Callers that wait for the suggestions of the word wait on the condition
+ * until the suggestions are ready or their time runs out. The \a notify flag
+ * is set if a caller did not get the suggestions in time, or if no caller is
+ * waiting for the word, then suggestionsReady() must be emitted once the
+ * suggestions are ready. */
+struct PendingWord
+{
+  QMutex mutex;
+  QWaitCondition condition;
+  bool finished = false;
+  bool notify   = false;
+  QStringList suggestions;
+};
+using PendingWordPtr = std::shared_ptr<PendingWord>;
+} // namespace
+
+class SpellChecker::SuggestionServicePrivate
+{
+public:
+  const ISpellChecker* spellChecker;
+  SuggestionService::SuggestionsCache cache;
+  QThreadPool threadPool;
+  mutable QMutex pendingMutex;             /*!< Guards the pendingWords. */
+  QHash<QString, PendingWordPtr> pendingWords;
+  std::atomic<bool> stopped{ false };
+
+  SuggestionServicePrivate( const ISpellChecker* checker )
+    : spellChecker( checker )
+    , cache( CACHE_ENTRIES_PER_STRIPE )
+  {
+    /* Only one word is processed at a time, at a low priority. This makes sure
+     * that the suggestions do not compete with the spell checking of files and
+     * the rest of the application. */
+    threadPool.setMaxThreadCount( 1 );
+    threadPool.setThreadPriority( QThread::LowPriority );
+  }
+};
+// --------------------------------------------------
+// --------------------------------------------------
+// --------------------------------------------------
+
+using namespace SpellChecker;
+
+SuggestionService::SuggestionService( const ISpellChecker* spellChecker )
+  : QObject( nullptr )
+  , d( new SuggestionServicePrivate( spellChecker ) )
+{}
+// --------------------------------------------------
+
+SuggestionService::~SuggestionService()
+{
+  stop();
+  delete d;
+}
+// --------------------------------------------------
+
+bool SuggestionService::suggestionsForWord( const QString& word, int32_t timeout, QStringList& suggestions )
+{
+  if( d->cache.find( word, suggestions ) == true ) {
+    return true;
+  }
+  if( d->stopped.load() == true ) {
+    return false;
+  }
+
+  PendingWordPtr pending;
+  {
+    QMutexLocker lock( &d->pendingMutex );
+    pending = d->pendingWords.value( word );
+    if( pending == nullptr ) {
+      /* Check the cache again, the word could have completed since the
+       * previous check. */
+      if( d->cache.find( word, suggestions ) == true ) {
+        return true;
+      }
+      pending = std::make_shared<PendingWord>();
+      d->pendingWords.insert( word, pending );
+      d->threadPool.start( [this, word]() { retrieveSuggestions( word ); }, PRIORITY_REQUESTED );
+    }
+  }
+
+  QMutexLocker lock( &pending->mutex );
+  QDeadlineTimer deadline( std::max( timeout, 0 ) );
+  while( pending->finished == false ) {
+    if( pending->condition.wait( &pending->mutex, deadline ) == false ) {
+      break;
+    }
+  }
+  if( pending->finished == true ) {
+    suggestions = pending->suggestions;
+    return true;
+  }
+  /* The time ran out, the word is left as pending and the suggestions will
+   * be reported using the suggestionsReady() signal. */
+  pending->notify = true;
+  return false;
+}
+// --------------------------------------------------
+
+bool SuggestionService::isPending( const QString& word ) const
+{
+  QMutexLocker lock( &d->pendingMutex );
+  return d->pendingWords.contains( word );
+}
+// --------------------------------------------------
+
+SuggestionService::SuggestionsCache& SuggestionService::cache()
+{
+  return d->cache;
+}
+// --------------------------------------------------
+
+const SuggestionService::SuggestionsCache& SuggestionService::cache() const
+{
+  return d->cache;
+}
+// --------------------------------------------------
+
+void SuggestionService::stop()
+{
+  d->stopped.store( true );
+  d->threadPool.clear();
+  d->threadPool.waitForDone();
+}
+// --------------------------------------------------
+
+void SuggestionService::retrieveSuggestions( const QString& word )
+{
+  if( d->stopped.load() == true ) {
+    return;
+  }
+  /* Hunspell does not provide a way to interrupt or limit the time of
+   * getting suggestions, thus once started the suggestions for the word
+   * must be retrieved completely. */
+  const uint64_t epoch = d->cache.epoch();
+  QStringList suggestions;
+  d->spellChecker->getSuggestionsForWord( word, suggestions );
+  d->cache.insert( word, suggestions, epoch );
+  const bool upToDate = ( epoch == d->cache.epoch() );
+
+  PendingWordPtr pending;
+  {
+    QMutexLocker lock( &d->pendingMutex );
+    pending = d->pendingWords.take( word );
+    if( ( upToDate == false )
+        && ( d->stopped.load() == false ) ) {
+      /* The cache was cleared while the suggestions were retrieved, they might
+       * be out of date. The callers that are waiting still get them, but the
+       * word stays pending and is retried in the background. */
+      PendingWordPtr retry = std::make_shared<PendingWord>();
+      retry->notify        = true;
+      d->pendingWords.insert( word, retry );
+      d->threadPool.start( [this, word]() { retrieveSuggestions( word ); }, PRIORITY_RETRY );
+    }
+  }
+  /* The signal is only emitted if someone did not get the suggestions
+   * directly, callers that got them in time already have them. */
+  bool notify = true;
+  if( pending != nullptr ) {
+    QMutexLocker lock( &pending->mutex );
+    pending->suggestions = suggestions;
+    pending->finished    = true;
+    notify               = pending->notify;
+    pending->condition.wakeAll();
+  }
+
+  if( ( upToDate == true )
+      && ( notify == true ) ) {
+    emit suggestionsReady( word );
+  }
+}
+// --------------------------------------------------
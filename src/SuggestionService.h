@@ -0,0 +1,104 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include "ConcurrentWordCache.h"
+
+#include <QObject>
+#include <QStringList>
+
+namespace SpellChecker {
+
+class ISpellChecker;
+class SuggestionServicePrivate;
+
+/*! \brief The SuggestionService class
+ *
+ * Service that gets suggestions for misspelled words from a spell checker
+ * in the background. Getting suggestions can be very slow for some words,
+ * long words or words with digits in them, and a caller should not be
+ * blocked for an unknown amount of time.
+ *
+ * All suggestions are retrieved on a separate low priority thread, one word
+ * at a time. A caller waits for the suggestions of a word for a limited time,
+ * if the suggestions are not ready at that time the word is marked as pending
+ * and the caller continues without suggestions. The suggestions for the word
+ * are still retrieved in the background, and once they are ready they are
+ * added to the suggestions cache and the suggestionsReady() signal is emitted.
+ *
+ * If the cache gets cleared while suggestions are retrieved for a pending
+ * word, the suggestions can be out of date. In that case the suggestions are
+ * not added to the cache and the word is retried in the background. */
+class SuggestionService
+  : public QObject
+{
+  Q_OBJECT
+public:
+  /*! \brief Alias for the cache of suggestions of misspelled words. */
+  using SuggestionsCache = ConcurrentWordCache<QStringList>;
+
+  /*! \brief Constructor
+   * \param spellChecker Spell checker that is used to get the suggestions. The
+   *        service must be stopped using stop() before the spell checker
+   *        is destroyed. */
+  explicit SuggestionService( const ISpellChecker* spellChecker );
+  ~SuggestionService() override;
+
+  /*! \brief Get the suggestions for the given \a word, waiting at most \a timeout
+   * milliseconds for them.
+   *
+   * \param[in] word Misspelled word that suggestions are needed for.
+   * \param[in] timeout Time in milliseconds to wait for the suggestions.
+   * \param[out] suggestions Suggestions for the word if they were ready in time.
+   * \return True if the suggestions were ready, false if the word is pending
+   *         and suggestionsReady() will be emitted once they are. */
+  bool suggestionsForWord( const QString& word, int32_t timeout, QStringList& suggestions );
+  /*! \brief Check if the suggestions for the \a word are still being retrieved. */
+  bool isPending( const QString& word ) const;
+  /*! \brief Get the cache of suggestions. */
+  SuggestionsCache& cache();
+  /*! \brief Get the cache of suggestions. */
+  const SuggestionsCache& cache() const;
+  /*! \brief Stop the service.
+   *
+   * All queued words are removed and the function waits for the word that is
+   * busy to complete. After this the service will not retrieve suggestions
+   * anymore. */
+  void stop();
+
+signals:
+  /*! \brief Signal emitted when the suggestions for a pending \a word are ready.
+   *
+   * The signal is only emitted for words that a caller did not get in time,
+   * or that were retried in the background. It is not emitted for words that
+   * all callers got within their timeout.
+   *
+   * This signal is emitted from the background thread. */
+  void suggestionsReady( const QString& word );
+
+private:
+  /*! \brief Function that runs in the background to get the suggestions for a word. */
+  void retrieveSuggestions( const QString& word );
+
+  SuggestionServicePrivate* const d;
+};
+
+} // namespace SpellChecker
@@ -20,10 +20,19 @@
 
 #pragma once
 
+#include "FlatWordList.h"
+
 #include <QDebug>
-#include <QMultiHash>
+#include <QHash>
+#include <QSet>
 #include <QString>
 #include <QStringList>
+#include <QStringView>
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
 
 namespace SpellChecker {
 
@@ -36,8 +45,11 @@ using QStringSet = QSet<QString>;
 /*! \brief The Word class
  *
  * This class is a structure representing a word parsed from the source. It
- * contains information about the word, where it is located and suggestions
- * for the word if it was misspelled.
+ * contains information about the word and where it is located.
+ *
+ * The words are used while a file is parsed and checked. Misspelled words
+ * that are kept by the models are stored as a CompactWord, and the
+ * suggestions for a word are kept by the spell checker per word text.
  */
 class Word
 {
@@ -45,17 +57,16 @@ public:
   Word() {}
   ~Word() {}
 
-  int32_t start;
-  int32_t end;
-  int32_t length;
+  int32_t start  = 0;
+  int32_t length = 0;
 
-  int32_t lineNumber;
-  int32_t columnNumber;
+  int32_t lineNumber   = 0;
+  int32_t columnNumber = 0;
   QString text;
   QString fileName;
-  QChar charAfter; /*!< Next character after the end of the word in the comment. */
-  bool  inComment; /*!< If the word comes from a comment or a String Literal. */
-  QStringList suggestions;
+  QChar charAfter;         /*!< Next character after the end of the word in the comment. */
+  bool  inComment = false; /*!< If the word comes from a comment or a String Literal. */
+  bool  isSplit   = false; /*!< If the word was split into smaller words, see WordView::isSplit. */
 
   bool operator==( const Word& other ) const
   {
@@ -66,34 +77,72 @@ public:
   }
 };
 
-/* Define used to use different types of word lists
- * for the spell checker. The 2 different types were defined
- * to test usage as well speed/performance of different
- * implementations. This was not done yet but might still be
- * done in future. */
-#define USE_MULTI_HASH
-#ifdef USE_MULTI_HASH
-class WordList
-  : public QMultiHash<QString, Word>
+/*! \brief Traits for a FlatWordList of Words, keyed on the text of the words. */
+template<>
+struct FlatWordListTraits<Word>
+{
+  using Key = QString;
+  static const QString& key( const Word& word ) { return word.text; }
+  static int32_t line( const Word& word ) { return word.lineNumber; }
+  static int32_t column( const Word& word ) { return word.columnNumber; }
+  static int32_t length( const Word& word ) { return word.length; }
+};
+
+/*! \brief List of words, in position order once finalized. */
+using WordList = FlatWordList<Word>;
+
+/*! \brief Shared, immutable list of words.
+ *
+ * The words of a file are handed from the parser to the spell checker and
+ * from the spell checker to the models. A list does not change anymore once
+ * it was created, thus all stages share the same list instead of copying it.
+ * A stage that needs a different list creates a new one. Shared lists must
+ * be finalized before they are shared. */
+using WordListPtr = std::shared_ptr<const WordList>;
+
+typedef QHash<QString /* File name */, WordList> FileWordList;
+
+/*! \brief The WordView class
+ *
+ * A word while it is still being parsed. The text of the word is a view into
+ * the string that the word was extracted from, thus it stays valid only as
+ * long as that string. Parsers use the views for all of the intermediate
+ * words and convert only the words that are kept into a Word, using
+ * toWord(). */
+class WordView
 {
 public:
-  inline WordList() {}
-  void append( const Word& t ) { this->insert( t.text, t ); }
-  void append( const WordList& l )
+  QStringView text;
+  int32_t start        = 0;
+  int32_t lineNumber   = 0;
+  int32_t columnNumber = 0;
+  QChar charBefore;        /*!< Character before the start of the word in the string. */
+  QChar charAfter;         /*!< Next character after the end of the word in the string. */
+  bool  inComment = false; /*!< If the word comes from a comment or a String Literal. */
+  bool  isSplit   = false; /*!< If the word was split into smaller words. Such a word is
+                            * never checked, it is only kept so that its parts can be
+                            * removed if the whole word is an identifier. */
+
+  /*! \brief Create a Word, owning its text, from the view. */
+  Word toWord( const QString& fileName ) const
   {
-    for( const Word& t: l ) {
-      append( t );
-    }
+    Word word;
+    word.start        = start;
+    word.length       = int32_t( text.size() );
+    word.lineNumber   = lineNumber;
+    word.columnNumber = columnNumber;
+    word.text         = text.toString();
+    word.fileName     = fileName;
+    word.charAfter    = charAfter;
+    word.inComment    = inComment;
+    word.isSplit      = isSplit;
+    return word;
   }
 };
 
-typedef WordList::iterator WordListIter;
-typedef WordList::const_iterator WordListConstIter;
-#else /* USE_MULTI_HASH */
-typedef QList<Word> WordList;
-#endif /* USE_MULTI_HASH */
-
-typedef QHash<QString /* File name */, WordList> FileWordList;
+/*! \brief List of word views, allocated from the memory resource of the
+ * parser job that created it. */
+using WordViewList = std::pmr::vector<WordView>;
 
 /*! \brief Class containing the words of a specific token.
  *
@@ -101,28 +150,35 @@ typedef QHash<QString /* File name */, WordList> FileWordList;
  * start position (line and column) of the token. The line and column is used
  * for keeping the offset correct if a token moved due to new tokens or text.
  * This is then used to adjust the line and column numbers of the words to the
- * correct locations. */
+ * correct locations.
+ *
+ * The length of the token is stored to verify that a token with the same
+ * hash is really the same token. */
 class TokenWords
 {
 public:
   int32_t line;
   int32_t col;
+  qsizetype length;
   WordList words;
 
-  TokenWords( int32_t l = 0, int32_t c = 0, const WordList& w = WordList() )
+  TokenWords( int32_t l = 0, int32_t c = 0, qsizetype len = 0, WordList w = WordList() )
     : line( l )
     , col( c )
-    , words( w ) {}
+    , length( len )
+    , words( std::move( w ) ) {}
 };
 /*! \brief Hash of a token and the corresponding list of words that were extracted from the token.
  *
- * The quint32 is result of the qHash(QString, 0) and stored in the hash for each token, along with
- * the list of words that were extracted from that comment. The hash of the token is used instead of
- * the string because there is no need for the extra memory in the hash to store the actual token.
+ * The quint64 is a strong 64-bit hash of the token and stored in the hash for each token, along with
+ * the list of words that were extracted from that comment. A 32-bit hash is not used since a
+ * collision would silently attach the words of one token to another in large projects.
+ * The hash of the token is used instead of the string because there is no need for the extra
+ * memory in the hash to store the actual token.
  * If the hash was defined as QHash<QString, CommentWords> the hash would store the full token in
  * memory so that it can be obtained using the QHash::key() function. Some token can be long and the
  * overhead is not needed. */
-using HashWords = QHash<quint32, TokenWords>;
+using HashWords = QHash<quint64, TokenWords>;
 
 } // namespace SpellChecker
 
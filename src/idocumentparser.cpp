@@ -39,12 +39,12 @@ bool IDocumentParser::isReservedWord( const QString& word )
     case 3:
       switch( word.at( 0 ).toUpper().toLatin1() ) {
         case 'C':
-          if( word.toUpper() == QStringLiteral( "CPP" ) ) {
+          if( word.compare( QLatin1String( "CPP" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
         case 'S':
-          if( word.toUpper() == QStringLiteral( "STD" ) ) {
+          if( word.compare( QLatin1String( "STD" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
@@ -53,7 +53,7 @@ bool IDocumentParser::isReservedWord( const QString& word )
     case 4:
       switch( word.at( 0 ).toUpper().toLatin1() ) {
         case 'E':
-          if( word.toUpper() == QStringLiteral( "ENUM" ) ) {
+          if( word.compare( QLatin1String( "ENUM" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
@@ -62,12 +62,12 @@ bool IDocumentParser::isReservedWord( const QString& word )
     case 6:
       switch( word.at( 0 ).toUpper().toLatin1() ) {
         case 'S':
-          if( word.toUpper() == QStringLiteral( "STRUCT" ) ) {
+          if( word.compare( QLatin1String( "STRUCT" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
         case 'P':
-          if( word.toUpper() == QStringLiteral( "PLUGIN" ) ) {
+          if( word.compare( QLatin1String( "PLUGIN" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
@@ -76,17 +76,17 @@ bool IDocumentParser::isReservedWord( const QString& word )
     case 7:
       switch( word.at( 0 ).toUpper().toLatin1() ) {
         case 'D':
-          if( word.toUpper() == QStringLiteral( "DOXYGEN" ) ) {
+          if( word.compare( QLatin1String( "DOXYGEN" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
         case 'N':
-          if( word.toUpper() == QStringLiteral( "NULLPTR" ) ) {
+          if( word.compare( QLatin1String( "NULLPTR" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
         case 'T':
-          if( word.toUpper() == QStringLiteral( "TYPEDEF" ) ) {
+          if( word.compare( QLatin1String( "TYPEDEF" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
@@ -95,7 +95,7 @@ bool IDocumentParser::isReservedWord( const QString& word )
     case 9:
       switch( word.at( 0 ).toUpper().toLatin1() ) {
         case 'N':
-          if( word.toUpper() == QStringLiteral( "NAMESPACE" ) ) {
+          if( word.compare( QLatin1String( "NAMESPACE" ), Qt::CaseInsensitive ) == 0 ) {
             return true;
           }
           break;
@@ -108,75 +108,17 @@ bool IDocumentParser::isReservedWord( const QString& word )
 }
 // --------------------------------------------------
 
-void IDocumentParser::getWordsFromSplitString( const QStringList& stringList, const Word& word, WordList& wordList )
+WordView IDocumentParser::subWordView( const WordView& word, qsizetype offset, qsizetype length )
 {
-  /* Now that the words are split, they need to be added to the WordList correctly */
-  int numbSplitWords = stringList.count();
-  int currentPos     = 0;
-  for( int wordIdx = 0; wordIdx < numbSplitWords; ++wordIdx ) {
-    Word newWord;
-    newWord.text         = stringList.at( wordIdx );
-    newWord.fileName     = word.fileName;
-    currentPos           = ( word.text ).indexOf( newWord.text, currentPos );
-    newWord.columnNumber = word.columnNumber + currentPos;
-    newWord.lineNumber   = word.lineNumber;
-    newWord.length       = newWord.text.length();
-    newWord.start        = word.start + currentPos;
-    newWord.end          = newWord.start + newWord.length;
-    newWord.inComment    = word.inComment;
-    currentPos           = currentPos + newWord.length;
-    /* Add the word to the end of the word list so that it can be checked against the
-     * settings later on */
-    wordList.append( newWord );
-  }
-}
-// --------------------------------------------------
-
-void IDocumentParser::removeWordsThatAppearInSource( const QStringSet& wordsInSource, WordList& words )
-{
-  /* Hopefully all words that are the same would be together in the WordList because of
-   * the nature of the QMultiHash. This would make removing multiple instances of the same
-   * word faster.
-   *
-   * The idea is to save the last word that was removed, and then for the next word,
-   * first compare it to the last word removed, and if it is the same, remove it from the list. Else
-   * search for the word in the wordsInSource list. The reasoning is that the first compare will be
-   * faster than the search in the wordsInSource list. But with this the overhead is added that now
-   * there is perhaps one more compare for each word that is not present in the source. Perhaps this
-   * can then be slower because the probability is that there will be more words not in the source
-   * than there are duplicate words that are in the source. For now this will be left this way but
-   * more benchmarking needs to be done to optimize.
-   *
-   * An initial test using QTime::start() and QTime::elapsed() showed the same speed of 3ms for
-   * either option for about 1425 potential words checked in 98 words occurring in the source. 148
-   * Words were removed for this test case. NOTE: Due to the inaccuracy of the timer on windows a
-   * better test will be performed in future. */
-#ifdef USE_MULTI_HASH
-  WordList::Iterator iter = words.begin();
-  QString lastWordRemoved;
-  while( iter != words.end() ) {
-    if( iter.key() == lastWordRemoved ) {
-      iter = words.erase( iter );
-    } else if( wordsInSource.contains( iter.key() ) ) {
-      lastWordRemoved = iter.key();
-      /* The word does appear in the source, thus remove it from the list of
-       * potential words that must be checked */
-      iter = words.erase( iter );
-    } else {
-      ++iter;
-    }
-  }
-#else /* USE_MULTI_HASH */
-  WordList::Iterator iter = words.begin();
-  while( iter != words.end() ) {
-    if( wordsInSource.contains( ( *iter ).text ) ) {
-      /* The word does appear in the source, thus remove it from the list of
-       * potential words that must be checked */
-      iter = words.erase( iter );
-    } else {
-      ++iter;
-    }
-  }
-#endif /* USE_MULTI_HASH */
+  /* The part of the word is still a view into the same string as the word, thus
+   * the positions are calculated from the offset and nothing gets copied. */
+  WordView newWord;
+  newWord.text         = word.text.sliced( offset, length );
+  newWord.start        = word.start + int32_t( offset );
+  newWord.lineNumber   = word.lineNumber;
+  newWord.columnNumber = word.columnNumber + int32_t( offset );
+  newWord.charBefore   = ( offset == 0 ) ? word.charBefore : word.text.at( offset - 1 );
+  newWord.inComment    = word.inComment;
+  return newWord;
 }
 // --------------------------------------------------
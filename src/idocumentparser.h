@@ -52,11 +52,10 @@ public:
   virtual Core::IOptionsPage* optionsPage() = 0;
 
   static bool isReservedWord( const QString& word );
-  static void getWordsFromSplitString( const QStringList& stringList, const Word& word, WordList& wordList );
-  static void removeWordsThatAppearInSource( const QStringSet& wordsInSource, WordList& words );
+  static WordView subWordView( const WordView& word, qsizetype offset, qsizetype length );
 protected:
 signals:
-  void spellcheckWordsParsed( const QString& fileName, const SpellChecker::WordList& wordlist );
+  void spellcheckWordsParsed( const QString& fileName, const SpellChecker::WordListPtr& wordlist );
 
 public slots:
   /*! Slot that will get called when the current editor changes.
@@ -88,6 +87,11 @@ public slots:
    * and then it is passed to the parsers. The parsers then does not need
    * to get the source files as well. */
   virtual void updateProjectFiles( QStringSet filesAdded, QStringSet filesRemoved ) { Q_UNUSED( filesAdded ) Q_UNUSED( filesRemoved ) }
+  /*! Slot that will get called when all files must be parsed again.
+   *
+   * This happens for example when the dictionary of the spell checker
+   * changed, and all words must be checked again. */
+  virtual void reparseProject() {}
 };
 
 } // namespace SpellChecker
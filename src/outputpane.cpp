@@ -340,8 +340,9 @@ void OutputPane::wordUnderCursorMistake( bool isMistake, const SpellChecker::Wor
   d->buttonSuggest->setEnabled( isMistake );
   d->buttonIgnore->setEnabled( isMistake );
   d->buttonAdd->setEnabled( isMistake );
-  /* Do not set the button for Lucky enabled if there is no suggestions for the word. */
-  d->buttonLucky->setEnabled( isMistake && ( word.suggestions.isEmpty() == false ) );
+  /* Do not set the button for Lucky enabled if there is no suggestions for the word.
+   * The suggestions are not waited for, this gets called again once they are ready. */
+  d->buttonLucky->setEnabled( isMistake && ( SpellCheckerCore::instance()->suggestionsForWord( word, 0 ).isEmpty() == false ) );
   /* Select the Word in the Output pane */
   QModelIndex index;
   if( isMistake == true ) {
@@ -51,6 +51,10 @@ const char SETTING_ONLY_PARSE_CURRENT[]       = "OnlyParseCurrentFile";
 const char SETTING_CHECK_EXTERNAL[]           = "CheckExternal";
 const char PROJECTS_TO_IGNORE[]               = "ProjectsToIgnore";
 const char REPLACE_ALL_FROM_RIGHT_CLICK[]     = "ReplaceAllFromRightClick";
+const char SETTING_SUGGESTIONS_TIMEOUT[]      = "SuggestionsTimeout";
+const char SETTING_TOKEN_CACHE_SIZE[]         = "TokenCacheSize";
+const char SETTING_MIN_FILES_IN_PROCESS[]     = "MinimumFilesInProcess";
+const char SETTING_MAX_FILES_IN_PROCESS[]     = "MaximumFilesInProcess";
 const char SETTINGS_OUTPUT_PANE_COL_WORD[]    = "ColWord";
 const char SETTINGS_OUTPUT_PANE_COL_LITERAL[] = "ColLiteral";
 const char SETTINGS_OUTPUT_PANE_COL_LINE[]    = "ColLine";
@@ -27,6 +27,7 @@
 #include "spellcheckercoreoptionswidget.h"
 #include "spellcheckercoresettings.h"
 #include "spellingmistakesmodel.h"
+#include "StringInterner.h"
 #include "suggestionsdialog.h"
 
 #include <coreplugin/session.h>
@@ -58,7 +59,7 @@
 #include <QTextBlock>
 #include <QTextCursor>
 
-using FutureWatcherMap     = QMap<QFutureWatcher<SpellChecker::WordList>*, QString>;
+using FutureWatcherMap     = QMap<QFutureWatcher<SpellChecker::CompactWordListPtr>*, QString>;
 using FutureWatcherMapIter = FutureWatcherMap::Iterator;
 
 class SpellChecker::Internal::SpellCheckerCorePrivate
@@ -82,7 +83,7 @@ public:
   QMutex futureMutex;
   FutureWatcherMap futureWatchers;
   QStringList filesInProcess;
-  QHash<QString, WordList> filesWaitingForProcess;
+  QHash<QString, WordListPtr> filesWaitingForProcess;
   bool shuttingDown = false;
 
   SpellCheckerCorePrivate()
@@ -114,7 +115,7 @@ SpellCheckerCore::SpellCheckerCore( QObject* parent )
   d->spellingMistakesModel = new ProjectMistakesModel();
 
   d->mistakesModel = new SpellingMistakesModel( this );
-  d->mistakesModel->setCurrentSpellingMistakes( WordList() );
+  d->mistakesModel->setCurrentSpellingMistakes( std::make_shared<const CompactWordList>() );
   connect( this, &SpellCheckerCore::activeProjectChanged, d->mistakesModel, &SpellingMistakesModel::setActiveProject );
 
   d->outputPane = new OutputPane( d->mistakesModel, this );
@@ -134,6 +135,20 @@ SpellCheckerCore::SpellCheckerCore( QObject* parent )
   connect( d->contextMenu->menu(), &QMenu::aboutToShow,            this, &SpellCheckerCore::updateContextMenu );
   connect( qApp,                   &QCoreApplication::aboutToQuit, this, &SpellCheckerCore::aboutToQuit, Qt::DirectConnection );
 
+  connect( &d->settings, &SpellCheckerCoreSettings::settingsChanged, this, [this]() {
+    /* Switch to the spell checker selected in the settings, the projects must
+     * then be checked again using the new checker. */
+    ISpellChecker* activeSpellChecker = d->addedSpellCheckers.value( d->settings.activeSpellChecker, nullptr );
+    if( ( activeSpellChecker != nullptr )
+        && ( activeSpellChecker != d->spellChecker ) ) {
+      setSpellChecker( activeSpellChecker );
+      dictionaryReloaded();
+    }
+    if( d->spellChecker != nullptr ) {
+      d->spellChecker->setSuggestionsTimeout( d->settings.suggestionsTimeout );
+    }
+  } );
+
   connect(Core::ICore::instance(), &Core::ICore::saveSettingsRequested,
           this, [this] { d->settings.saveToSettings(Core::ICore::settings()); });
 }
@@ -188,7 +203,7 @@ void SpellCheckerCore::removeDocumentParser( IDocumentParser* parser )
 }
 // --------------------------------------------------
 
-void SpellCheckerCore::addMisspelledWords( const QString& fileName, const WordList& words )
+void SpellCheckerCore::addMisspelledWords( const QString& fileName, const CompactWordListPtr& words )
 {
   d->spellingMistakesModel->insertSpellingMistakes( fileName, words, d->filesInStartupProject.contains( fileName ) );
   if( d->currentFilePath == fileName ) {
@@ -216,10 +231,8 @@ void SpellCheckerCore::addMisspelledWords( const QString& fileName, const WordLi
     return;
   }
   QList<QTextEdit::ExtraSelection> selections;
-  selections.reserve( words.size() );
-  const WordList::ConstIterator wordsEnd = words.constEnd();
-  for( WordList::ConstIterator wordIter = words.constBegin(); wordIter != wordsEnd; ++wordIter ) {
-    const Word& word = wordIter.value();
+  selections.reserve( words->size() );
+  for( const CompactWord& word: *words ) {
     /* Get the QTextBlock for the line that the misspelled word is on.
      * The QTextDocument manages lines as blocks (in most cases).
      * The lineNumber of the misspelled word is 1 based (seen in the editor)
@@ -233,13 +246,13 @@ void SpellCheckerCore::addMisspelledWords( const QString& fileName, const WordLi
      * the blocks and cursor are 0 based. */
     const QTextBlock& block = document->findBlockByNumber( int32_t( word.lineNumber ) - 1 );
     if( ( block.isValid() == false )
-        || ( uint32_t( block.length() ) < ( word.columnNumber - 1 + uint32_t( word.length ) ) ) ) {
+        || ( uint32_t( block.length() ) < ( uint32_t( word.columnNumber ) - 1 + uint32_t( word.length ) ) ) ) {
       continue;
     }
 
     QTextCursor cursor( block );
     cursor.setPosition( cursor.position() + int32_t( word.columnNumber ) - 1 );
-    cursor.movePosition( QTextCursor::Right, QTextCursor::KeepAnchor, word.length );
+    cursor.movePosition( QTextCursor::Right, QTextCursor::KeepAnchor, int32_t( word.length ) );
     /* Get the current format from the cursor, this is to make sure that the text font
      * and color stays the same, we just want to underline the mistake. */
     QTextCharFormat format = cursor.charFormat();
@@ -247,9 +260,15 @@ void SpellCheckerCore::addMisspelledWords( const QString& fileName, const WordLi
     static const QColor underLineColor = QColor( Qt::red );
     format.setUnderlineColor( underLineColor );
     format.setUnderlineStyle( QTextCharFormat::WaveUnderline );
-    format.setToolTip( word.suggestions.isEmpty()
+    /* Suggestions are only calculated on demand, thus only use them for the
+     * tooltip if they are already known. */
+    QStringList suggestions;
+    if( d->spellChecker != nullptr ) {
+      d->spellChecker->cachedSuggestionsForWord( word.text(), suggestions );
+    }
+    format.setToolTip( suggestions.isEmpty()
                        ? QStringLiteral( "Incorrect spelling" )
-                       : QStringLiteral( "Incorrect spelling, did you mean '%1' ?" ).arg( word.suggestions.first() ) );
+                       : QStringLiteral( "Incorrect spelling, did you mean '%1' ?" ).arg( suggestions.first() ) );
     QTextEdit::ExtraSelection selection;
     selection.cursor = cursor;
     selection.format = format;
@@ -296,8 +315,10 @@ void SpellCheckerCore::addSpellChecker( ISpellChecker* spellChecker )
 
   d->addedSpellCheckers.insert( spellChecker->name(), spellChecker );
 
-  /* If none is set, set it to the one added */
-  if( d->spellChecker == nullptr ) {
+  /* If none is set, set it to the one added. If the added one is the
+   * checker selected in the settings, it becomes the active checker. */
+  if( ( d->spellChecker == nullptr )
+      || ( spellChecker->name() == d->settings.activeSpellChecker ) ) {
     setSpellChecker( spellChecker );
   }
 }
@@ -313,11 +334,18 @@ void SpellCheckerCore::setSpellChecker( ISpellChecker* spellChecker )
     d->addedSpellCheckers.insert( spellChecker->name(), spellChecker );
   }
 
+  if( d->spellChecker != nullptr ) {
+    disconnect( d->spellChecker, &ISpellChecker::suggestionsReady,   this, &SpellCheckerCore::suggestionsReady );
+    disconnect( d->spellChecker, &ISpellChecker::dictionaryReloaded, this, &SpellCheckerCore::dictionaryReloaded );
+  }
   d->spellChecker = spellChecker;
+  d->spellChecker->setSuggestionsTimeout( d->settings.suggestionsTimeout );
+  connect( d->spellChecker, &ISpellChecker::suggestionsReady,   this, &SpellCheckerCore::suggestionsReady,   Qt::QueuedConnection );
+  connect( d->spellChecker, &ISpellChecker::dictionaryReloaded, this, &SpellCheckerCore::dictionaryReloaded, Qt::QueuedConnection );
 }
 // --------------------------------------------------
 
-void SpellCheckerCore::spellcheckWordsFromParser( const QString& fileName, const WordList& words )
+void SpellCheckerCore::spellcheckWordsFromParser( const QString& fileName, const WordListPtr& words )
 {
   /* Lock the mutex to prevent threading issues. This might not be needed since
    * queued connections are used and this function should always execute in the
@@ -343,15 +371,12 @@ void SpellCheckerCore::spellcheckWordsFromParser( const QString& fileName, const
      * the latest words that should be spell checked. */
     d->filesWaitingForProcess[fileName] = words;
   } else {
-    /* Get the list of mistakes that were extracted on the file during the last
-     * run of the processing. */
-    WordList previousMistakes = d->spellingMistakesModel->mistakesForFile( fileName );
     /* There is no background process processing the words for the given file.
      * Create a processor and start processing the spelling mistakes in the
      * background using QtConcurrent and a QFuture. */
-    SpellCheckProcessor* processor    = new SpellCheckProcessor( d->spellChecker, fileName, words, previousMistakes );
-    QFutureWatcher<WordList>* watcher = new QFutureWatcher<WordList>();
-    connect( watcher, &QFutureWatcher<WordList>::finished, this, &SpellCheckerCore::futureFinished, Qt::QueuedConnection );
+    SpellCheckProcessor* processor    = new SpellCheckProcessor( d->spellChecker, fileName, words );
+    QFutureWatcher<CompactWordListPtr>* watcher = new QFutureWatcher<CompactWordListPtr>();
+    connect( watcher, &QFutureWatcher<CompactWordListPtr>::finished, this, &SpellCheckerCore::futureFinished, Qt::QueuedConnection );
     /* Keep track of the watchers that are busy and the file that it is working on.
      * Since all QFuterWatchers are connected to the same slot, this map is used
      * to map the correct watcher to the correct file. */
@@ -364,7 +389,7 @@ void SpellCheckerCore::spellcheckWordsFromParser( const QString& fileName, const
     d->filesInProcess.append( fileName );
     /* Make sure that the processor gets cleaned up after it has finished processing
      * the words. */
-    connect( watcher, &QFutureWatcher<WordList>::finished, processor, &SpellCheckProcessor::deleteLater );
+    connect( watcher, &QFutureWatcher<CompactWordListPtr>::finished, processor, &SpellCheckProcessor::deleteLater );
 
     /* Create a future to process the file.
      * If the file to process is the current open editor, it is processed in a new
@@ -375,10 +400,10 @@ void SpellCheckerCore::spellcheckWordsFromParser( const QString& fileName, const
      * soon as possible and it does not need to get queued along with all other
      * futures added to the global thread pool. */
     if( fileName == d->currentFilePath ) {
-      QFuture<WordList> future = Utils::asyncRun( QThread::HighPriority, &SpellCheckProcessor::process, processor );
+      QFuture<CompactWordListPtr> future = Utils::asyncRun( QThread::HighPriority, &SpellCheckProcessor::process, processor );
       watcher->setFuture( future );
     } else {
-      QFuture<WordList> future = Utils::asyncRun( QThreadPool::globalInstance(), QThread::LowPriority, &SpellCheckProcessor::process, processor );
+      QFuture<CompactWordListPtr> future = Utils::asyncRun( QThreadPool::globalInstance(), QThread::LowPriority, &SpellCheckProcessor::process, processor );
       watcher->setFuture( future );
     }
   }
@@ -390,7 +415,7 @@ void SpellCheckerCore::futureFinished()
   /* Get the watcher from the sender() of the signal that invoked this slot.
    * reinterpret_cast is used since qobject_cast is not valid of template
    * classes since the template class does not have the Q_OBJECT macro. */
-  QFutureWatcher<WordList>* watcher = reinterpret_cast<QFutureWatcher<WordList>*>( sender() );
+  QFutureWatcher<CompactWordListPtr>* watcher = reinterpret_cast<QFutureWatcher<CompactWordListPtr>*>( sender() );
   if( watcher == nullptr ) {
     return;
   }
@@ -404,7 +429,7 @@ void SpellCheckerCore::futureFinished()
     return;
   }
   /* Get the list of words with spelling mistakes from the future. */
-  WordList checkedWords = watcher->result();
+  const CompactWordListPtr checkedWords = watcher->result();
   QMutexLocker locker( &d->futureMutex );
   /* Recheck again after getting the lock. */
   if( d->shuttingDown == true ) {
@@ -425,9 +450,9 @@ void SpellCheckerCore::futureFinished()
    * if a spell check was requested for a file that had a future already in
    * progress, it was scheduled for a re-check as soon as the in progress one
    * completes. If it was scheduled, restart it using the normal slot. */
-  QHash<QString, WordList>::iterator waitingIter = d->filesWaitingForProcess.find( fileName );
+  QHash<QString, WordListPtr>::iterator waitingIter = d->filesWaitingForProcess.find( fileName );
   if( waitingIter != d->filesWaitingForProcess.end() ) {
-    WordList wordsToSpellCheck = waitingIter.value();
+    WordListPtr wordsToSpellCheck = std::move( waitingIter.value() );
     /* remove the file and words from the scheduled list. */
     d->filesWaitingForProcess.erase( waitingIter );
     locker.unlock();
@@ -438,7 +463,7 @@ void SpellCheckerCore::futureFinished()
                                       , "spellcheckWordsFromParser"
                                       , Qt::QueuedConnection
                                       , Q_ARG( QString, fileName )
-                                      , Q_ARG( SpellChecker::WordList, wordsToSpellCheck ) );
+                                      , Q_ARG( SpellChecker::WordListPtr, wordsToSpellCheck ) );
   } else {
       locker.unlock();
   }
@@ -506,24 +531,23 @@ bool SpellCheckerCore::isWordUnderCursorMistake( Word& word ) const
   int32_t column           = d->currentEditor->currentColumn();
   int32_t line             = d->currentEditor->currentLine();
   QString  currentFileName = d->currentEditor->document()->filePath().toString();
-  WordList wl;
-  wl = d->spellingMistakesModel->mistakesForFile( currentFileName );
-  if( wl.isEmpty() == true ) {
+  const CompactWordListPtr wl = d->spellingMistakesModel->mistakesForFile( currentFileName );
+  const CompactWord* currentWord = wl->wordAt( line, column );
+  if( currentWord == nullptr ) {
     return false;
   }
-  WordList::ConstIterator iter          = wl.constBegin();
-  const WordList::ConstIterator iterEnd = wl.constEnd();
-  while( iter != iterEnd ) {
-    const Word& currentWord = iter.value();
-    if( ( currentWord.lineNumber == line )
-        && ( ( currentWord.columnNumber <= column )
-             && ( ( currentWord.columnNumber + currentWord.length ) >= column ) ) ) {
-      word = currentWord;
-      return true;
-    }
-    ++iter;
+  word = currentWord->toWord();
+  return true;
+}
+// --------------------------------------------------
+
+QStringList SpellCheckerCore::suggestionsForWord( const Word& word, int32_t timeout ) const
+{
+  QStringList suggestions;
+  if( d->spellChecker != nullptr ) {
+    d->spellChecker->suggestionsForWord( word.text, suggestions, timeout );
   }
-  return false;
+  return suggestions;
 }
 // --------------------------------------------------
 
@@ -532,21 +556,19 @@ bool SpellCheckerCore::getAllOccurrencesOfWord( const Word& word, WordList& word
   if( d->currentEditor.isNull() == true ) {
     return false;
   }
-  WordList wl;
   QString  currentFileName = d->currentEditor->document()->filePath().toString();
-  wl = d->spellingMistakesModel->mistakesForFile( currentFileName );
-  if( wl.isEmpty() == true ) {
+  const CompactWordListPtr wl = d->spellingMistakesModel->mistakesForFile( currentFileName );
+  const StringInterner::Id wordId = StringInterner::words().find( word.text );
+  if( ( wl->isEmpty() == true )
+      || ( wordId == StringInterner::INVALID_ID ) ) {
     return false;
   }
-  WordList::ConstIterator iter = wl.constBegin();
-  while( iter != wl.constEnd() ) {
-    const Word& currentWord = iter.value();
-    if( currentWord.text == word.text ) {
-      words.append( currentWord );
-    }
-    ++iter;
+  /* Occurrences of the same text share the same id, only those words are
+   * expanded for the caller. */
+  for( const CompactWord& compactWord: wl->occurrences( wordId ) ) {
+    words.append( compactWord.toWord() );
   }
-  return ( wl.count() > 0 );
+  return ( words.count() > 0 );
 
 }
 // --------------------------------------------------
@@ -565,7 +587,7 @@ void SpellCheckerCore::giveSuggestionsForWordUnderCursor()
 
   getAllOccurrencesOfWord( word, wordsToReplace );
 
-  SuggestionsDialog dialog( word.text, word.suggestions, wordsToReplace.count() );
+  SuggestionsDialog dialog( word.text, suggestionsForWord( word ), wordsToReplace.count() );
   SuggestionsDialog::ReturnCode code = static_cast<SuggestionsDialog::ReturnCode>( dialog.exec() );
   switch( code ) {
     case SuggestionsDialog::Rejected:
@@ -607,13 +629,41 @@ void SpellCheckerCore::replaceWordUnderCursorFirstSuggestion()
     Q_ASSERT( wordMistake );
     return;
   }
-  if( word.suggestions.isEmpty() == true ) {
+  const QStringList suggestions = suggestionsForWord( word );
+  if( suggestions.isEmpty() == true ) {
     /* Word does not have any suggestions */
     return;
   }
   WordList words;
   words.append( word );
-  replaceWordsInCurrentEditor( words, word.suggestions.first() );
+  replaceWordsInCurrentEditor( words, suggestions.first() );
+}
+// --------------------------------------------------
+
+void SpellCheckerCore::suggestionsReady( const QString& word )
+{
+  d->mistakesModel->suggestionsReady( word );
+  /* If the word under the cursor is the word that the suggestions are
+   * ready for, update the word so that the suggestions become available. */
+  Word wordUnderCursor;
+  if( ( isWordUnderCursorMistake( wordUnderCursor ) == true )
+      && ( wordUnderCursor.text == word ) ) {
+    emit wordUnderCursorMistake( true, wordUnderCursor );
+  }
+}
+// --------------------------------------------------
+
+void SpellCheckerCore::dictionaryReloaded()
+{
+  if( d->shuttingDown == true ) {
+    return;
+  }
+  /* The new dictionary is ready, all files must be checked again. */
+  for( const QPointer<IDocumentParser>& parser: std::as_const( d->documentParsers ) ) {
+    if( parser.isNull() == false ) {
+      parser->reparseProject();
+    }
+  }
 }
 // --------------------------------------------------
 
@@ -660,7 +710,7 @@ void SpellCheckerCore::removeWordUnderCursor( RemoveAction action )
      * re-parse the whole project, it will be a lot faster doing this.  */
     d->spellingMistakesModel->removeAllOccurrences( word.text );
     /* Get the updated list associated with the file. */
-    WordList newList = d->spellingMistakesModel->mistakesForFile( currentFileName );
+    const CompactWordListPtr newList = d->spellingMistakesModel->mistakesForFile( currentFileName );
     /* Re-add the mistakes for the file. This is at the moment a doing the same
      * thing twice, but until the 2 mistakes models are not combined this will be
      * needed for the mistakes in the  output pane to update. */
@@ -714,11 +764,28 @@ void SpellCheckerCore::replaceWordsInCurrentEditor( const WordList& wordsToRepla
 }
 // --------------------------------------------------
 
+void SpellCheckerCore::compactStringTables()
+{
+  QSet<StringInterner::Id> wordIds;
+  QSet<StringInterner::Id> fileIds;
+  const CompactWordListPtr currentMistakes = d->mistakesModel->currentSpellingMistakes();
+  for( const CompactWord& word: *currentMistakes ) {
+    wordIds.insert( word.wordId );
+    fileIds.insert( word.fileId );
+  }
+  StringInterner::words().compact( wordIds );
+  StringInterner::files().compact( fileIds );
+}
+// --------------------------------------------------
+
 void SpellCheckerCore::startupProjectChanged( ProjectExplorer::Project* startupProject )
 {
   /* Cancel all outstanding futures */
   cancelFutures();
   d->spellingMistakesModel->clearAllSpellingMistakes();
+  /* Nothing refers to the strings of the previous project anymore, except the
+   * mistakes of the current editor. */
+  compactStringTables();
   d->filesInStartupProject.clear();
   d->startupProject = startupProject;
   if( startupProject != nullptr ) {
@@ -785,11 +852,7 @@ void SpellCheckerCore::mangerEditorChanged( Core::IEditor* editor )
 
   emit currentEditorChanged( d->currentFilePath );
 
-  WordList wl;
-  if( d->currentFilePath.isEmpty() == false ) {
-    wl = d->spellingMistakesModel->mistakesForFile( d->currentFilePath );
-  }
-  d->mistakesModel->setCurrentSpellingMistakes( wl );
+  d->mistakesModel->setCurrentSpellingMistakes( d->spellingMistakesModel->mistakesForFile( d->currentFilePath ) );
 }
 // --------------------------------------------------
 
@@ -834,7 +897,7 @@ void SpellCheckerCore::updateContextMenu()
   if( isMistake == false ) {
     return;
   }
-  QStringList list = word.suggestions;
+  QStringList list = suggestionsForWord( word );
   /* Iterate the commands and */
   for( Core::Command* cmd: qAsConst( d->contextMenuHolderCommands ) ) {
     Q_ASSERT( cmd != nullptr );
@@ -20,7 +20,7 @@
 
 #pragma once
 
-#include "Word.h"
+#include "CompactWord.h"
 
 #include <coreplugin/editormanager/editormanager.h>
 #include <projectexplorer/project.h>
@@ -85,8 +85,9 @@ public:
   QMap<QString, ISpellChecker*> addedSpellCheckers() const;
   /*! \brief Add a spell checker to the list of available checkers.
    *
-   * If there are no active spell checker set on the object, the added
-   * object will be set as the active checker.
+   * If there are no active spell checker set on the object, or if the added
+   * checker is the active checker in the settings, the added object will be
+   * set as the active checker.
    * \sa setSpellChecker()
    * \sa spellChecker() */
   void addSpellChecker( ISpellChecker* spellChecker );
@@ -111,6 +112,17 @@ public:
    * \return True if the word is misspelled.
    */
   bool isWordUnderCursorMistake( Word& word ) const;
+  /*! \brief Get the suggestions for a misspelled word.
+   *
+   * The suggestions are not stored with the misspelled words, they are kept
+   * once per word text by the spell checker and retrieved from it when needed.
+   * \param[in] word Misspelled word that suggestions are needed for.
+   * \param[in] timeout Time in milliseconds to wait for the suggestions. If
+   *              negative, the time set in the settings is used. If the
+   *              suggestions are not ready in time, an empty list is returned
+   *              and wordUnderCursorMistake() is emitted again once they are.
+   * \return Suggestions for the word. */
+  QStringList suggestionsForWord( const Word& word, int32_t timeout = -1 ) const;
   /*! \brief Replace Words In CurrentEditor.
    * Replace the given words in the current editor with the supplied replacement word.
    * \param[in] wordsToReplace List of words to replace
@@ -136,6 +148,13 @@ private:
    * \param[in] action Action to use to remove the word.
    */
   void removeWordUnderCursor( RemoveAction action );
+  /*! \brief Remove the strings that are no longer used from the global
+   * StringInterner tables.
+   *
+   * Must only be called once no futures are running and the mistakes of the
+   * project were cleared. Only the strings of the mistakes of the current
+   * editor are kept. */
+  void compactStringTables();
 
 signals:
   /*! \brief Signal emitted to inform the plugin if the word under the cursor is a mistake.
@@ -192,7 +211,7 @@ public slots:
    * checking all words for the given file.
    * \param[in] fileName Name of the file that the misspelled words belong to.
    * \param[in] words List of misspelled words for the given file. */
-  void addMisspelledWords( const QString& fileName, const SpellChecker::WordList& words );
+  void addMisspelledWords( const QString& fileName, const SpellChecker::CompactWordListPtr& words );
 
 private slots:
   /*! \brief Spellcheck Words from Parser
@@ -203,7 +222,7 @@ private slots:
    * \param[in] fileName Name of the file that the words belong to.
    * \param[in] words List of words that must be checked for spelling mistakes.
    */
-  void spellcheckWordsFromParser( const QString& fileName, const SpellChecker::WordList& words );
+  void spellcheckWordsFromParser( const QString& fileName, const SpellChecker::WordListPtr& words );
   /*! \brief Slot called when the Qt Creator Startup or active project changes. */
   void startupProjectChanged( ProjectExplorer::Project* startupProject );
   /*! \brief Slot called when the files in the project changes. */
@@ -234,6 +253,16 @@ private slots:
   void cancelFutures();
   /*! \brief Slot called when Qt Creator is about to quit. */
   void aboutToQuit();
+  /*! \brief Slot called when the suggestions for a word that was pending
+   * are known.
+   *
+   * Updates the views that show the suggestions for the \a word. */
+  void suggestionsReady( const QString& word );
+  /*! \brief Slot called when the spell checker replaced its dictionary.
+   *
+   * Requests all parsers to parse their files again so that the words can
+   * be checked against the new dictionary. */
+  void dictionaryReloaded();
 private:
   Internal::SpellCheckerCorePrivate* const d;
 };
@@ -129,6 +129,10 @@ SpellCheckerCoreSettings SpellCheckerCoreOptionsWidget::settings()
   settings.checkExternalFiles       = ui.checkBoxCheckExternal->isChecked();
   settings.projectsToIgnore         = m_projectsToIgnore;
   settings.replaceAllFromRightClick = ui.checkBoxReplaceAllRightClick->isChecked();
+  settings.suggestionsTimeout       = ui.spinBoxSuggestionsTimeout->value();
+  settings.tokenCacheSize           = ui.spinBoxTokenCacheSize->value();
+  settings.minimumFilesInProcess    = ui.spinBoxMinimumFilesInProcess->value();
+  settings.maximumFilesInProcess    = ui.spinBoxMaximumFilesInProcess->value();
   return settings;
 }
 // --------------------------------------------------
@@ -180,6 +184,10 @@ void SpellCheckerCoreOptionsWidget::updateWithSettings( const SpellCheckerCoreSe
   ui.listWidget->clear();
   ui.listWidget->addItems( m_projectsToIgnore );
   ui.checkBoxReplaceAllRightClick->setChecked( settings->replaceAllFromRightClick );
+  ui.spinBoxSuggestionsTimeout->setValue( settings->suggestionsTimeout );
+  ui.spinBoxTokenCacheSize->setValue( settings->tokenCacheSize );
+  ui.spinBoxMinimumFilesInProcess->setValue( settings->minimumFilesInProcess );
+  ui.spinBoxMaximumFilesInProcess->setValue( settings->maximumFilesInProcess );
 }
 // --------------------------------------------------
 
@@ -30,6 +30,10 @@ SpellCheckerCoreSettings::SpellCheckerCoreSettings()
   , checkExternalFiles( false )
   , projectsToIgnore()
   , replaceAllFromRightClick( true )
+  , suggestionsTimeout( 250 )
+  , tokenCacheSize( 32 )
+  , minimumFilesInProcess( 2 )
+  , maximumFilesInProcess( 64 )
 {}
 // --------------------------------------------------
 
@@ -40,6 +44,10 @@ SpellCheckerCoreSettings::SpellCheckerCoreSettings( const SpellCheckerCoreSettin
   , checkExternalFiles( settings.checkExternalFiles )
   , projectsToIgnore( settings.projectsToIgnore )
   , replaceAllFromRightClick( settings.replaceAllFromRightClick )
+  , suggestionsTimeout( settings.suggestionsTimeout )
+  , tokenCacheSize( settings.tokenCacheSize )
+  , minimumFilesInProcess( settings.minimumFilesInProcess )
+  , maximumFilesInProcess( settings.maximumFilesInProcess )
 {}
 // --------------------------------------------------
 
@@ -55,6 +63,10 @@ void SpellCheckerCoreSettings::saveToSettings( Utils::QtcSettings* settings ) co
   settings->setValue( Constants::SETTING_CHECK_EXTERNAL,       checkExternalFiles );
   settings->setValue( Constants::PROJECTS_TO_IGNORE,           projectsToIgnore );
   settings->setValue( Constants::REPLACE_ALL_FROM_RIGHT_CLICK, replaceAllFromRightClick );
+  settings->setValue( Constants::SETTING_SUGGESTIONS_TIMEOUT,  suggestionsTimeout );
+  settings->setValue( Constants::SETTING_TOKEN_CACHE_SIZE,     tokenCacheSize );
+  settings->setValue( Constants::SETTING_MIN_FILES_IN_PROCESS, minimumFilesInProcess );
+  settings->setValue( Constants::SETTING_MAX_FILES_IN_PROCESS, maximumFilesInProcess );
   settings->endGroup(); /* CORE_SETTINGS_GROUP */
   settings->sync();
 }
@@ -68,6 +80,10 @@ void SpellCheckerCoreSettings::loadFromSettings( Utils::QtcSettings* settings )
   checkExternalFiles       = settings->value( Constants::SETTING_CHECK_EXTERNAL, checkExternalFiles ).toBool();
   projectsToIgnore         = settings->value( Constants::PROJECTS_TO_IGNORE, projectsToIgnore ).toStringList();
   replaceAllFromRightClick = settings->value( Constants::REPLACE_ALL_FROM_RIGHT_CLICK, replaceAllFromRightClick ).toBool();
+  suggestionsTimeout       = settings->value( Constants::SETTING_SUGGESTIONS_TIMEOUT, suggestionsTimeout ).toInt();
+  tokenCacheSize           = settings->value( Constants::SETTING_TOKEN_CACHE_SIZE, tokenCacheSize ).toInt();
+  minimumFilesInProcess    = settings->value( Constants::SETTING_MIN_FILES_IN_PROCESS, minimumFilesInProcess ).toInt();
+  maximumFilesInProcess    = settings->value( Constants::SETTING_MAX_FILES_IN_PROCESS, maximumFilesInProcess ).toInt();
   settings->endGroup(); /* CORE_SETTINGS_GROUP */
 }
 // --------------------------------------------------
@@ -81,6 +97,10 @@ SpellCheckerCoreSettings& SpellCheckerCoreSettings::operator=( const SpellChecke
     this->checkExternalFiles       = other.checkExternalFiles;
     this->projectsToIgnore         = other.projectsToIgnore;
     this->replaceAllFromRightClick = other.replaceAllFromRightClick;
+    this->suggestionsTimeout       = other.suggestionsTimeout;
+    this->tokenCacheSize           = other.tokenCacheSize;
+    this->minimumFilesInProcess    = other.minimumFilesInProcess;
+    this->maximumFilesInProcess    = other.maximumFilesInProcess;
     emit settingsChanged();
   }
   return *this;
@@ -95,6 +115,10 @@ bool SpellCheckerCoreSettings::operator==( const SpellCheckerCoreSettings& other
   different = different | ( checkExternalFiles != other.checkExternalFiles );
   different = different | ( projectsToIgnore != other.projectsToIgnore );
   different = different | ( replaceAllFromRightClick != other.replaceAllFromRightClick );
+  different = different | ( suggestionsTimeout != other.suggestionsTimeout );
+  different = different | ( tokenCacheSize != other.tokenCacheSize );
+  different = different | ( minimumFilesInProcess != other.minimumFilesInProcess );
+  different = different | ( maximumFilesInProcess != other.maximumFilesInProcess );
   return ( different == false );
 }
 // --------------------------------------------------
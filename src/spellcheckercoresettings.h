@@ -49,6 +49,17 @@ public:
   /*! Replace all occurrences of a misspelled word on the current page when
    * a suggestion is selected from the right click menu. */
   bool replaceAllFromRightClick;
+  /*! Time in milliseconds to wait for the suggestions of a misspelled word
+   * before continuing without them. The suggestions are then retrieved
+   * in the background. */
+  int32_t suggestionsTimeout;
+  /*! Maximum size in MiB of the cache that keeps the words of the tokens of
+   * recently parsed files, so that unchanged tokens need not be parsed again. */
+  int32_t tokenCacheSize;
+  /*! Minimum and maximum number of files that are parsed at the same time.
+   * The number in between is adapted to how fast the files are parsed. */
+  int32_t minimumFilesInProcess;
+  int32_t maximumFilesInProcess;
 
 signals:
   void settingsChanged();
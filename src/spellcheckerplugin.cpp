@@ -26,7 +26,9 @@
 #include "spellcheckquickfix.h"
 
 /* SpellCheckers */
+#include "SpellCheckers/CompiledDictionaryChecker/compileddictionarychecker.h"
 #include "SpellCheckers/HunspellChecker/hunspellchecker.h"
+#include "SpellCheckers/WordListChecker/wordlistchecker.h"
 
 /* Parsers */
 #include "Parsers/CppParser/cppdocumentparser.h"
@@ -61,6 +63,8 @@ public:
   std::unique_ptr<CppSpellChecker::Internal::CppParserSettings> cppParserSettings;
   std::unique_ptr<NavigationWidgetFactory> navFactory;
   std::unique_ptr<SpellChecker::ISpellChecker> spellChecker;
+  std::unique_ptr<SpellChecker::ISpellChecker> compiledDictionaryChecker;
+  std::unique_ptr<SpellChecker::ISpellChecker> wordListChecker;
   std::unique_ptr<SpellChecker::IDocumentParser> cppParser;
   std::unique_ptr<SpellCheckCppQuickFixFactory>  quickFixFactory;
 };
@@ -95,6 +99,7 @@ SpellCheckerPlugin::SpellCheckerPlugin()
   : d( new SpellCheckerPluginPrivate() )
 {
   qRegisterMetaType<SpellChecker::WordList>( "SpellChecker::WordList" );
+  qRegisterMetaType<SpellChecker::WordListPtr>( "SpellChecker::WordListPtr" );
 }
 
 SpellCheckerPlugin::~SpellCheckerPlugin()
@@ -141,7 +146,7 @@ Utils::Result<> SpellCheckerPlugin::initialize(const QStringList& arguments)
   connect( d->spellCheckerCore.get(), &SpellCheckerCore::wordUnderCursorMistake, actionIgnore,              &QAction::setEnabled );
   connect( d->spellCheckerCore.get(), &SpellCheckerCore::wordUnderCursorMistake, actionAdd,                 &QAction::setEnabled );
   connect( d->spellCheckerCore.get(), &SpellCheckerCore::wordUnderCursorMistake, actionLucky,               [=]( bool isMistake, const SpellChecker::Word& word ) {
-    actionLucky->setEnabled( isMistake && ( word.suggestions.isEmpty() == false ) );
+    actionLucky->setEnabled( isMistake && ( SpellCheckerCore::instance()->suggestionsForWord( word, 0 ).isEmpty() == false ) );
   } );
 
   Core::ActionContainer* menu = Core::ActionManager::createMenu( Constants::MENU_ID );
@@ -178,7 +183,13 @@ Utils::Result<> SpellCheckerPlugin::initialize(const QStringList& arguments)
   /* --- Create the default Spell Checker and Document Parser --- */
   /* Hunspell Spell Checker */
   d->spellChecker = std::make_unique<SpellChecker::Checker::Hunspell::HunspellChecker>();
-  d->spellCheckerCore->setSpellChecker( d->spellChecker.get() );
+  d->spellCheckerCore->addSpellChecker( d->spellChecker.get() );
+  /* Compiled Dictionary Spell Checker */
+  d->compiledDictionaryChecker = std::make_unique<SpellChecker::Checker::CompiledDictionary::CompiledDictionaryChecker>();
+  d->spellCheckerCore->addSpellChecker( d->compiledDictionaryChecker.get() );
+  /* Word List Spell Checker */
+  d->wordListChecker = std::make_unique<SpellChecker::Checker::WordList::WordListChecker>();
+  d->spellCheckerCore->addSpellChecker( d->wordListChecker.get() );
 
   /* Cpp Document Parser */
   d->cppParser = std::make_unique<SpellChecker::CppSpellChecker::Internal::CppDocumentParser>();
@@ -110,15 +110,16 @@ void SpellCheckCppQuickFixFactory::doMatch( const CppEditor::Internal::CppQuickF
   }
 
   /* The word is a mistake, add the suggestions to the list of quick fixes. */
+  const QStringList suggestions = core->suggestionsForWord( word );
   WordList words;
   words.append( word );
-  int priority = word.suggestions.count();
-  result.reserve( word.suggestions.count() + 2 );
+  int priority = suggestions.count();
+  result.reserve( suggestions.count() + 2 );
   /* The priority is offset with negative 30 to allow other operations to
    * appear first in the list of fixes, with the spelling mistakes last. */
   priority -= 30;
   /* Iterate the suggestions and add them to the list of fixes. */
-  for( const QString& suggestion: word.suggestions ) {
+  for( const QString& suggestion: suggestions ) {
     TextEditor::QuickFixOperation::Ptr quickFix( new Internal::SpellCheckReplaceWordOperation( words, suggestion ) );
     quickFix->setPriority( --priority );
     result.append( TextEditor::QuickFixOperation::Ptr( quickFix ) );
@@ -18,9 +18,11 @@
 ** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
 ****************************************************************************/
 
+#include "ISpellChecker.h"
 #include "spellcheckerconstants.h"
+#include "spellcheckercore.h"
 #include "spellingmistakesmodel.h"
-#include "Word.h"
+#include "StringInterner.h"
 
 #include <QDir>
 
@@ -38,7 +40,12 @@ public:
     : m_columnIndex( columnIndex )
     , m_order( order ) {}
 
-  inline bool operator()( const Word& word1, const Word& word2 )
+  inline bool operator()( const CompactWord* word1, const CompactWord* word2 )
+  {
+    return operator()( *word1, *word2 );
+  }
+
+  inline bool operator()( const CompactWord& word1, const CompactWord& word2 )
   {
     if( m_order == Qt::AscendingOrder ) {
       return lessThan( word1, word2 );
@@ -47,7 +54,7 @@ public:
     }
   }
 
-  inline bool lessThan( const Word& word1, const Word& word2 )
+  inline bool lessThan( const CompactWord& word1, const CompactWord& word2 )
   {
     switch( m_columnIndex ) {
       /* Can only sort to line, word and literal columns. */
@@ -63,7 +70,12 @@ public:
           return predicate( word1, word2 );
         }
       case Constants::MISTAKE_COLUMN_WORD:
-        return word1.text < word2.text;
+        /* Occurrences of the same word have the same id, only words that
+         * differ needs their text from the intern table. */
+        if( word1.wordId == word2.wordId ) {
+          return false;
+        }
+        return word1.text() < word2.text();
       case Constants::MISTAKE_COLUMN_LINE:
         /* If the line numbers are not the same, return the one with the
          * highest line number. Otherwise if the line numbers are the same,
@@ -89,7 +101,8 @@ private:
 class SpellChecker::Internal::SpellingMistakesModelPrivate
 {
 public:
-  QList<SpellChecker::Word> wordList;
+  SpellChecker::CompactWordListPtr words; /*!< Shared list of words, keeps the rows valid. */
+  QVector<const SpellChecker::CompactWord*> wordList; /*!< Rows of the model, in sorted order. */
   Constants::MistakesModelColumn sortColumn;
   Qt::SortOrder sortOrder;
   QDir projectDir;
@@ -118,10 +131,17 @@ SpellingMistakesModel::~SpellingMistakesModel()
 }
 // --------------------------------------------------
 
-void SpellingMistakesModel::setCurrentSpellingMistakes( const SpellChecker::WordList& words )
+void SpellingMistakesModel::setCurrentSpellingMistakes( const SpellChecker::CompactWordListPtr& words )
 {
   beginResetModel();
-  d->wordList = words.values();
+  /* The rows point into the shared list, the list does not change thus the
+   * pointers stay valid for as long as the model keeps the list. */
+  d->words = words;
+  d->wordList.clear();
+  d->wordList.reserve( words->size() );
+  for( const CompactWord& word: *words ) {
+    d->wordList.append( &word );
+  }
   sort( d->sortColumn, d->sortOrder );
   endResetModel();
   emit layoutChanged();
@@ -129,13 +149,26 @@ void SpellingMistakesModel::setCurrentSpellingMistakes( const SpellChecker::Word
 }
 // --------------------------------------------------
 
+SpellChecker::CompactWordListPtr SpellingMistakesModel::currentSpellingMistakes() const
+{
+  return d->words;
+}
+// --------------------------------------------------
+
 QModelIndex SpellingMistakesModel::indexOfWord( const Word& word ) const
 {
-  int idx = d->wordList.indexOf( word );
-  if( idx == -1 ) {
+  /* All rows are for the same file, thus the word is found on its position
+   * in the shared list, and then the row that shows it is looked up. */
+  const CompactWord* compactWord = d->words->wordAt( word.lineNumber, word.columnNumber );
+  if( ( compactWord == nullptr )
+      || ( compactWord->wordId != StringInterner::words().find( word.text ) ) ) {
     /* The word was not found in the List, return the invalid index */
     return QModelIndex();
   }
+  const int idx = int( d->wordList.indexOf( compactWord ) );
+  if( idx == -1 ) {
+    return QModelIndex();
+  }
 
   /* The word was found, get an index and return it */
   return createIndex( idx, 0 );
@@ -172,8 +205,8 @@ QVariant SpellingMistakesModel::data( const QModelIndex& index, int role ) const
   if( ( role == Qt::DecorationRole )
       && ( column == Constants::MISTAKE_COLUMN_LITERAL ) ) {
     /* Display the icon if the word is a string literal. */
-    Word currentWord = d->wordList.at( row );
-    if( currentWord.inComment == false ) {
+    const CompactWord& currentWord = *d->wordList.at( row );
+    if( currentWord.inComment == 0 ) {
       /* Create and store the icon in a static QIcon variable. It is made
        * static so that there is no need to construct the icon on each
        * call to this code. The downside is that it might need an IDE restart
@@ -200,21 +233,31 @@ QVariant SpellingMistakesModel::data( const QModelIndex& index, int role ) const
   }
 
   /* Get the display role. */
-  Word currentWord = d->wordList.at( row );
+  const CompactWord& currentWord = *d->wordList.at( row );
   switch( column ) {
     case Constants::MISTAKE_COLUMN_IDX:
       return row + 1;
     case Constants::MISTAKE_COLUMN_WORD:
-      return currentWord.text;
-    case Constants::MISTAKE_COLUMN_SUGGESTIONS:
-      return currentWord.suggestions.join( QStringLiteral( ", " ) );
+      return currentWord.text();
+    case Constants::MISTAKE_COLUMN_SUGGESTIONS: {
+      /* Suggestions are only retrieved for the words that are displayed.
+       * The model does not wait for the suggestions, if they are pending
+       * the row gets updated in suggestionsReady(). */
+      ISpellChecker* spellChecker = SpellCheckerCore::instance()->spellChecker();
+      if( spellChecker == nullptr ) {
+        return QVariant();
+      }
+      QStringList suggestions;
+      spellChecker->suggestionsForWord( currentWord.text(), suggestions, 0 );
+      return suggestions.join( QStringLiteral( ", " ) );
+    }
     case Constants::MISTAKE_COLUMN_LITERAL:
       /* No text, only the image above. */
       return QVariant();
     case Constants::MISTAKE_COLUMN_LINE:
-      return currentWord.lineNumber;
+      return int32_t( currentWord.lineNumber );
     case Constants::MISTAKE_COLUMN_COLUMN:
-      return currentWord.columnNumber;
+      return int32_t( currentWord.columnNumber );
     default:
       return QVariant();
   }
@@ -278,5 +321,20 @@ void SpellingMistakesModel::setActiveProject( ProjectExplorer::Project* activePr
   Q_ASSERT( d->projectDir.exists() == true );
 }
 // --------------------------------------------------
+
+void SpellingMistakesModel::suggestionsReady( const QString& word )
+{
+  const StringInterner::Id wordId = StringInterner::words().find( word );
+  if( wordId == StringInterner::INVALID_ID ) {
+    return;
+  }
+  for( int row = 0; row < d->wordList.size(); ++row ) {
+    if( d->wordList.at( row )->wordId == wordId ) {
+      const QModelIndex suggestionsIndex = index( row, Constants::MISTAKE_COLUMN_SUGGESTIONS );
+      emit dataChanged( suggestionsIndex, suggestionsIndex );
+    }
+  }
+}
+// --------------------------------------------------
 // --------------------------------------------------
 // --------------------------------------------------
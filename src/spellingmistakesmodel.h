@@ -22,7 +22,7 @@
 
 #include <projectexplorer/project.h>
 
-#include "Word.h"
+#include "CompactWord.h"
 
 #include <QAbstractTableModel>
 
@@ -43,8 +43,12 @@ public:
    * This function clears the previous words and sets the model
    * to contain the new \a words. This will then be reflected on
    * all views connected to the model.
-   * \param[in] words List of words that must be set on the model. */
-  void setCurrentSpellingMistakes( const WordList& words );
+   * \param[in] words List of words that must be set on the model. The
+   *              model shares the list, it is not copied. */
+  void setCurrentSpellingMistakes( const CompactWordListPtr& words );
+  /*! \brief Get the words of the model.
+   * \return The list that was set with setCurrentSpellingMistakes(). */
+  CompactWordListPtr currentSpellingMistakes() const;
   /*! \brief Get the index of the word.
   *
   * Get the index of the \a word from the model.
@@ -69,6 +73,12 @@ public slots:
    * show the relative paths to the files with the spelling mistakes.
    * \param[in] activeProject Pointer to the active project. */
   void setActiveProject( ProjectExplorer::Project* activeProject );
+  /*! \brief Slot called when the suggestions for a word that was pending
+   * are known.
+   *
+   * Updates the suggestions of all rows for the \a word.
+   * \param[in] word Word that the suggestions are known for. */
+  void suggestionsReady( const QString& word );
 private:
   SpellingMistakesModelPrivate* const d;
 };
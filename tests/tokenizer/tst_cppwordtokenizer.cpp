@@ -0,0 +1,285 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+/*! \file
+ * \brief Golden test for the CppWordTokenizer.
+ *
+ * Runs the strings of a fixed corpus through the tokenizer and compares the
+ * words that are found with the words that were recorded from the character
+ * by character reference implementation, isEndOfCurrentWord(), both without
+ * and with website characters as part of words. The reference must still
+ * find the recorded words as well. Example:
+ *
+ *   spellchecker-tokenizer-test tests/tokenizer/data
+ *
+ * The golden files are recorded again from the reference implementation
+ * with:
+ *
+ *   spellchecker-tokenizer-test --generate tests/tokenizer/data
+ *
+ * The data directory contains:
+ *  - corpus.txt: The strings, separated by lines that only contain "%%".
+ *  - words.golden: For each string one line with the words that were found,
+ *    each as the start position in UTF-16 characters, a ':' and the word.
+ *  - words-websites.golden: The same, with website characters in words. */
+
+#include "../../src/Parsers/CppParser/cppparserconstants.h"
+#include "../../src/Parsers/CppParser/cppwordtokenizer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QRegularExpression>
+#include <QStringList>
+
+using SpellChecker::CppSpellChecker::Internal::CppWordTokenizer;
+
+namespace {
+/*! \brief Read the UTF-8 file \a fileName without a trailing new line. */
+bool readFile( const QString& fileName, QString& contents )
+{
+  QFile file( fileName );
+  if( file.open( QIODevice::ReadOnly ) == false ) {
+    qCritical().noquote() << "Could not open" << fileName << ":" << file.errorString();
+    return false;
+  }
+  contents = QString::fromUtf8( file.readAll() );
+  contents.remove( QLatin1Char( '\r' ) );
+  if( contents.endsWith( QLatin1Char( '\n' ) ) == true ) {
+    contents.chop( 1 );
+  }
+  return true;
+}
+// --------------------------------------------------
+
+/*! \brief Check if the end of a possible word was reached.
+ *
+ * Character by character reference implementation of the rules of the
+ * CppWordTokenizer. This is the implementation that the C++ parser used before
+ * the tokenizer, the golden files are recorded from it.
+ * \param[in] comment String to check.
+ * \param[in] currentPos Position of the character in the \a comment.
+ * \param[in] websiteCharsInWords If website characters are part of words.
+ * \return True if the character is the end of a word. */
+bool isEndOfCurrentWord( QStringView comment, int currentPos, bool websiteCharsInWords )
+{
+  /* Check to see if the current position is past the length of the comment. If this
+   * is the case, then clearly it is the end of the current word */
+  if( currentPos >= comment.length() ) {
+    return true;
+  }
+
+  const QChar currentChar = comment[currentPos];
+  /* The regular expressions below match single characters of the comment. The
+   * characters are wrapped in a string without copying them. */
+  const auto charAt = [&comment]( int pos ) {
+    return QString::fromRawData( comment.data() + pos, 1 );
+  };
+
+  /* Check if the current character is a letter, number or underscore. */
+  if( ( currentChar.isLetterOrNumber() == true )
+      || ( currentChar == QLatin1Char( '_' ) ) ) {
+    return false;
+  }
+
+  /* Check for an apostrophe in a word. This is for words like we're. Not all
+   * apostrophes are part of a word, like words that starts with and end with */
+  if( currentChar == QLatin1Char( '\'' ) ) {
+    /* Do some range checking, is this is the first or last character then
+     * this is not part of a word, thus it is the end of the current word */
+    if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
+      return true;
+    }
+    if( ( comment.at( currentPos + 1 ).isLetter() == true )
+        && ( comment.at( currentPos - 1 ).isLetter() == true ) ) {
+      return false;
+    }
+  }
+
+  /* For words with '.' in, such as abbreviations and email addresses */
+  if( currentChar == QLatin1Char( '.' ) ) {
+    if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
+      return true;
+    }
+    static const QRegularExpression wordChars( QStringLiteral( "\\w" ) );
+    if( ( wordChars.match( charAt( currentPos + 1 ) ).hasMatch() )
+        && ( wordChars.match( charAt( currentPos - 1 ) ).hasMatch() ) ) {
+      return false;
+    }
+  }
+
+  /* For word with @ in: Email address */
+  if( currentChar == QLatin1Char( '@' ) ) {
+    if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
+      return true;
+    }
+    static const QRegularExpression wordChars( QStringLiteral( "\\w" ) );
+    if( ( wordChars.match( charAt( currentPos + 1 ) ).hasMatch() )
+        && ( wordChars.match( charAt( currentPos - 1 ) ).hasMatch() ) ) {
+      return false;
+    }
+  }
+
+  /* Check for websites, only if the website characters are part of words. */
+  if( websiteCharsInWords == true ) {
+    static const QRegularExpression websiteChars( QStringLiteral( "\\w|" ) + QLatin1String( SpellChecker::Parsers::CppParser::Constants::WEBSITE_CHARS_REGEXP_PATTERN ) );
+    if( websiteChars.match( charAt( currentPos ) ).hasMatch() == true ) {
+      if( ( currentPos == 0 ) || ( currentPos == ( comment.length() - 1 ) ) ) {
+        return true;
+      }
+      if( ( websiteChars.match( charAt( currentPos + 1 ) ).hasMatch() == true )
+          && ( websiteChars.match( charAt( currentPos - 1 ) ).hasMatch() == true ) ) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+// --------------------------------------------------
+
+/*! \brief Add the word from \a wordStart to \a position in the \a string to
+ * the \a words, in the format of the golden files. */
+void appendWord( QStringList& words, QStringView string, qsizetype wordStart, qsizetype position )
+{
+  words << QString::number( wordStart ) + QLatin1Char( ':' ) + string.sliced( wordStart, position - wordStart ).toString();
+}
+// --------------------------------------------------
+
+/*! \brief Find the words in the \a string with the tokenizer. */
+QString findWords( const CppWordTokenizer& tokenizer, QStringView string )
+{
+  QStringList words;
+  qsizetype position  = 0;
+  qsizetype wordStart = 0;
+  while( tokenizer.nextWord( string, position, wordStart ) == true ) {
+    appendWord( words, string, wordStart, position );
+  }
+  return words.join( QLatin1Char( ' ' ) );
+}
+// --------------------------------------------------
+
+/*! \brief Find the words in the \a string with the reference implementation. */
+QString findReferenceWords( QStringView string, bool websiteCharsInWords )
+{
+  QStringList words;
+  bool busyWithWord   = false;
+  qsizetype wordStart = 0;
+  for( qsizetype position = 0; position <= string.size(); ++position ) {
+    const bool endOfWord = isEndOfCurrentWord( string, int( position ), websiteCharsInWords );
+    if( ( endOfWord == false ) && ( busyWithWord == false ) ) {
+      wordStart    = position;
+      busyWithWord = true;
+    }
+    if( ( busyWithWord == true ) && ( endOfWord == true ) ) {
+      appendWord( words, string, wordStart, position );
+      busyWithWord = false;
+    }
+  }
+  return words.join( QLatin1Char( ' ' ) );
+}
+// --------------------------------------------------
+
+/*! \brief Record the words that the reference implementation finds in the
+ * \a corpus to the golden file.
+ * \return True if the file was written. */
+bool generate( const QStringList& corpus, const QString& goldenFileName, bool websiteCharsInWords )
+{
+  QFile file( goldenFileName );
+  if( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false ) {
+    qCritical().noquote() << "Could not write" << goldenFileName << ":" << file.errorString();
+    return false;
+  }
+  for( const QString& string: corpus ) {
+    file.write( findReferenceWords( string, websiteCharsInWords ).toUtf8() + '\n' );
+  }
+  return true;
+}
+// --------------------------------------------------
+
+/*! \brief Compare the words found in the \a corpus with the golden file.
+ * \return Number of strings for which different words were found. */
+int compare( const QStringList& corpus, const QString& goldenFileName, bool websiteCharsInWords )
+{
+  QString golden;
+  if( readFile( goldenFileName, golden ) == false ) {
+    return 1;
+  }
+  const QStringList expected = golden.split( QLatin1Char( '\n' ) );
+  if( expected.size() != corpus.size() ) {
+    qCritical().noquote() << goldenFileName << "has" << expected.size() << "lines for" << corpus.size() << "strings";
+    return 1;
+  }
+
+  const CppWordTokenizer tokenizer( websiteCharsInWords );
+  int failures = 0;
+  for( qsizetype index = 0; index < corpus.size(); ++index ) {
+    const QString actual    = findWords( tokenizer, corpus.at( index ) );
+    const QString reference = findReferenceWords( corpus.at( index ), websiteCharsInWords );
+    if( ( actual != expected.at( index ) )
+        || ( reference != expected.at( index ) ) ) {
+      qCritical().noquote() << "Mismatch for string" << index + 1 << "with website characters" << websiteCharsInWords
+                            << "\n  string:   " << corpus.at( index )
+                            << "\n  expected: " << expected.at( index )
+                            << "\n  tokenizer:" << actual
+                            << "\n  reference:" << reference;
+      ++failures;
+    }
+  }
+  return failures;
+}
+// --------------------------------------------------
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+  QCoreApplication app( argc, argv );
+  const bool generateGolden = ( argc == 3 ) && ( qstrcmp( argv[1], "--generate" ) == 0 );
+  if( ( argc != 2 ) && ( generateGolden == false ) ) {
+    qCritical().noquote() << "Usage: spellchecker-tokenizer-test [--generate] <data directory>";
+    return 2;
+  }
+  const QString dataDirectory = QString::fromLocal8Bit( argv[argc - 1] ) + QLatin1Char( '/' );
+
+  QString corpusText;
+  if( readFile( dataDirectory + QStringLiteral( "corpus.txt" ), corpusText ) == false ) {
+    return 1;
+  }
+  const QStringList corpus = corpusText.split( QStringLiteral( "\n%%\n" ) );
+
+  if( generateGolden == true ) {
+    if( ( generate( corpus, dataDirectory + QStringLiteral( "words.golden" ), false ) == false )
+        || ( generate( corpus, dataDirectory + QStringLiteral( "words-websites.golden" ), true ) == false ) ) {
+      return 1;
+    }
+    qInfo().noquote() << "Recorded the words of" << corpus.size() << "strings";
+    return 0;
+  }
+
+  int failures = 0;
+  failures += compare( corpus, dataDirectory + QStringLiteral( "words.golden" ), false );
+  failures += compare( corpus, dataDirectory + QStringLiteral( "words-websites.golden" ), true );
+  if( failures != 0 ) {
+    qCritical().noquote() << failures << "of" << corpus.size() * 2 << "strings failed";
+    return 1;
+  }
+  qInfo().noquote() << "All" << corpus.size() * 2 << "strings passed";
+  return 0;
+}
@@ -0,0 +1,301 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#include "affixexpander.h"
+
+#include <QFile>
+#include <QStringDecoder>
+
+using namespace SpellChecker::DictionaryCompiler;
+
+namespace {
+/*! \brief Convert a Hunspell affix condition to a regular expression.
+ *
+ * A condition only consists of characters, '.' for any character and
+ * character groups '[...]' or '[^...]', everything else is matched
+ * literally. */
+QString conditionPattern( const QString& condition )
+{
+  if( condition == QLatin1String( "." ) ) {
+    return QString();
+  }
+  QString pattern;
+  bool inGroup = false;
+  for( const QChar character: condition ) {
+    if( character == QLatin1Char( '[' ) ) {
+      inGroup = true;
+      pattern += character;
+    } else if( character == QLatin1Char( ']' ) ) {
+      inGroup = false;
+      pattern += character;
+    } else if( ( inGroup == true ) && ( character == QLatin1Char( '^' ) ) ) {
+      pattern += character;
+    } else if( ( inGroup == false ) && ( character == QLatin1Char( '.' ) ) ) {
+      pattern += character;
+    } else {
+      pattern += QRegularExpression::escape( QString( character ) );
+    }
+  }
+  return pattern;
+}
+// --------------------------------------------------
+
+QStringList splitFields( const QString& line )
+{
+  static const QRegularExpression whitespace( QStringLiteral( "\\s+" ) );
+  return line.split( whitespace, Qt::SkipEmptyParts );
+}
+// --------------------------------------------------
+} // namespace
+
+bool AffixExpander::loadAffixFile( const QString& fileName, QString* error )
+{
+  QFile file( fileName );
+  if( file.open( QIODevice::ReadOnly ) == false ) {
+    if( error != nullptr ) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  const QByteArray data = file.readAll();
+
+  /* The encoding must be known before the rest of the file can be decoded. */
+  static const QRegularExpression setOption( QStringLiteral( "^SET\\s+(\\S+)" ), QRegularExpression::MultilineOption );
+  const QRegularExpressionMatch setMatch = setOption.match( QString::fromLatin1( data ) );
+  if( setMatch.hasMatch() == true ) {
+    d_encoding = setMatch.captured( 1 ).toLatin1().toUpper();
+    /* Hunspell uses ISO8859-X while the codec names are ISO-8859-X */
+    if( d_encoding.startsWith( "ISO8859-" ) == true ) {
+      d_encoding.replace( "ISO8859-", "ISO-8859-" );
+    }
+  }
+  if( QStringDecoder( d_encoding.constData() ).isValid() == false ) {
+    if( error != nullptr ) {
+      *error = QStringLiteral( "Unsupported encoding %1" ).arg( QString::fromLatin1( d_encoding ) );
+    }
+    return false;
+  }
+
+  const QStringList lines = decode( data ).split( QLatin1Char( '\n' ) );
+  bool aliasCountRead = false;
+  for( const QString& line: lines ) {
+    const QStringList fields = splitFields( line );
+    if( ( fields.isEmpty() == true )
+        || ( fields.first().startsWith( QLatin1Char( '#' ) ) == true ) ) {
+      continue;
+    }
+    const QString& option = fields.first();
+    if( fields.size() < 2 ) {
+      continue;
+    }
+    if( option == QLatin1String( "TRY" ) ) {
+      d_tryCharacters = fields.at( 1 );
+    } else if( option == QLatin1String( "FLAG" ) ) {
+      if( fields.at( 1 ) == QLatin1String( "long" ) ) {
+        d_flagType = FlagType::Long;
+      } else if( fields.at( 1 ) == QLatin1String( "num" ) ) {
+        d_flagType = FlagType::Numeric;
+      } else if( fields.at( 1 ) == QLatin1String( "UTF-8" ) ) {
+        d_flagType = FlagType::Utf8;
+      }
+    } else if( option == QLatin1String( "AF" ) ) {
+      /* The first AF line contains the number of aliases. */
+      if( aliasCountRead == true ) {
+        d_flagAliases.append( parseFlagString( fields.at( 1 ) ) );
+      }
+      aliasCountRead = true;
+    } else if( option == QLatin1String( "NEEDAFFIX" ) ) {
+      d_needAffixFlag = fields.at( 1 );
+    } else if( option == QLatin1String( "FORBIDDENWORD" ) ) {
+      d_forbiddenFlag = fields.at( 1 );
+    } else if( option == QLatin1String( "ONLYINCOMPOUND" ) ) {
+      d_onlyInCompoundFlag = fields.at( 1 );
+    } else if( ( option == QLatin1String( "PFX" ) )
+               || ( option == QLatin1String( "SFX" ) ) ) {
+      if( fields.size() < 4 ) {
+        continue;
+      }
+      const QString& flag = fields.at( 1 );
+      if( d_classes.contains( flag ) == false ) {
+        /* The first line of a class is the header: PFX flag Y|N count */
+        AffixClass affixClass;
+        affixClass.isPrefix     = ( option == QLatin1String( "PFX" ) );
+        affixClass.crossProduct = ( fields.at( 2 ) == QLatin1String( "Y" ) );
+        d_classes.insert( flag, affixClass );
+        continue;
+      }
+      /* The rules: PFX flag strip affix[/continuation] [condition] */
+      AffixEntry entry;
+      entry.strip = ( fields.at( 2 ) == QLatin1String( "0" ) ) ? QString() : fields.at( 2 );
+      entry.affix = fields.at( 3 ).section( QLatin1Char( '/' ), 0, 0 );
+      if( entry.affix == QLatin1String( "0" ) ) {
+        entry.affix.clear();
+      }
+      const QString condition = conditionPattern( ( fields.size() > 4 ) ? fields.at( 4 ) : QStringLiteral( "." ) );
+      if( condition.isEmpty() == false ) {
+        const bool isPrefix = d_classes.value( flag ).isPrefix;
+        entry.condition = QRegularExpression( isPrefix ? ( QLatin1Char( '^' ) + condition ) : ( condition + QLatin1Char( '$' ) ) );
+        entry.condition.optimize();
+      }
+      d_classes[flag].entries.append( entry );
+    }
+  }
+  return true;
+}
+// --------------------------------------------------
+
+QString AffixExpander::decode( const QByteArray& data ) const
+{
+  QStringDecoder decoder( d_encoding.constData() );
+  return decoder.decode( data );
+}
+// --------------------------------------------------
+
+QString AffixExpander::tryCharacters() const
+{
+  return d_tryCharacters;
+}
+// --------------------------------------------------
+
+QStringList AffixExpander::expand( const QString& line ) const
+{
+  /* Remove the morphological fields after the word and its flags. */
+  const QString entry = splitFields( line ).value( 0 );
+  const qsizetype slash = entry.indexOf( QLatin1Char( '/' ) );
+  const QString word    = ( slash == -1 ) ? entry : entry.left( slash );
+  if( word.isEmpty() == true ) {
+    return {};
+  }
+  const QStringList flags = ( slash == -1 ) ? QStringList() : parseFlags( entry.mid( slash + 1 ) );
+
+  if( ( ( d_forbiddenFlag.isEmpty() == false ) && ( flags.contains( d_forbiddenFlag ) == true ) )
+      || ( ( d_onlyInCompoundFlag.isEmpty() == false ) && ( flags.contains( d_onlyInCompoundFlag ) == true ) ) ) {
+    return {};
+  }
+
+  QStringList forms;
+  if( ( d_needAffixFlag.isEmpty() == true )
+      || ( flags.contains( d_needAffixFlag ) == false ) ) {
+    forms.append( word );
+  }
+
+  /* Suffixes first, the forms that allow a cross product are kept to
+   * combine them with the prefixes. */
+  QStringList crossForms = { word };
+  for( const QString& flag: flags ) {
+    const auto iter = d_classes.constFind( flag );
+    if( ( iter == d_classes.constEnd() )
+        || ( iter->isPrefix == true ) ) {
+      continue;
+    }
+    for( const AffixEntry& affixEntry: iter->entries ) {
+      if( applies( affixEntry, false, word ) == true ) {
+        const QString form = apply( affixEntry, false, word );
+        forms.append( form );
+        if( iter->crossProduct == true ) {
+          crossForms.append( form );
+        }
+      }
+    }
+  }
+
+  for( const QString& flag: flags ) {
+    const auto iter = d_classes.constFind( flag );
+    if( ( iter == d_classes.constEnd() )
+        || ( iter->isPrefix == false ) ) {
+      continue;
+    }
+    const QStringList& bases = ( iter->crossProduct == true ) ? crossForms : QStringList { word };
+    for( const AffixEntry& affixEntry: iter->entries ) {
+      for( const QString& base: bases ) {
+        if( applies( affixEntry, true, base ) == true ) {
+          forms.append( apply( affixEntry, true, base ) );
+        }
+      }
+    }
+  }
+  return forms;
+}
+// --------------------------------------------------
+
+QStringList AffixExpander::parseFlags( const QString& flags ) const
+{
+  /* With aliases the flags are the number of the alias. */
+  if( d_flagAliases.isEmpty() == false ) {
+    bool ok         = false;
+    const int alias = flags.toInt( &ok );
+    if( ( ok == true )
+        && ( alias > 0 )
+        && ( alias <= d_flagAliases.size() ) ) {
+      return d_flagAliases.at( alias - 1 );
+    }
+  }
+  return parseFlagString( flags );
+}
+// --------------------------------------------------
+
+QStringList AffixExpander::parseFlagString( const QString& flags ) const
+{
+  QStringList result;
+  switch( d_flagType ) {
+    case FlagType::Long:
+      for( qsizetype index = 0; index + 1 < flags.size(); index += 2 ) {
+        result.append( flags.mid( index, 2 ) );
+      }
+      break;
+    case FlagType::Numeric:
+      result = flags.split( QLatin1Char( ',' ), Qt::SkipEmptyParts );
+      break;
+    case FlagType::Short:
+    case FlagType::Utf8:
+      for( const QChar flag: flags ) {
+        result.append( QString( flag ) );
+      }
+      break;
+  }
+  return result;
+}
+// --------------------------------------------------
+
+bool AffixExpander::applies( const AffixEntry& entry, bool isPrefix, const QString& word ) const
+{
+  if( word.size() <= entry.strip.size() ) {
+    return false;
+  }
+  if( isPrefix == true ) {
+    if( word.startsWith( entry.strip ) == false ) {
+      return false;
+    }
+  } else if( word.endsWith( entry.strip ) == false ) {
+    return false;
+  }
+  return ( ( entry.condition.pattern().isEmpty() == true )
+           || ( entry.condition.match( word ).hasMatch() == true ) );
+}
+// --------------------------------------------------
+
+QString AffixExpander::apply( const AffixEntry& entry, bool isPrefix, const QString& word ) const
+{
+  if( isPrefix == true ) {
+    return entry.affix + word.mid( entry.strip.size() );
+  }
+  return word.chopped( entry.strip.size() ) + entry.affix;
+}
+// --------------------------------------------------
@@ -0,0 +1,99 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace SpellChecker {
+namespace DictionaryCompiler {
+
+/*! \brief Expands the words of a Hunspell dictionary with their affixes.
+ *
+ * The expander reads the rules of a Hunspell *.aff file and then generates
+ * all the forms of a *.dic entry that Hunspell would accept. Only the parts
+ * of the affix file needed to generate the word forms are supported:
+ *  - SET, TRY, FLAG (short, long, num and UTF-8) and AF.
+ *  - PFX and SFX rules with strip, affix and condition, and cross products.
+ *  - NEEDAFFIX, FORBIDDENWORD and ONLYINCOMPOUND.
+ *
+ * Continuation classes on affixes and compounding are not supported. For
+ * dictionaries that depend on them, the expanded word list from the Hunspell
+ * unmunch tool can be used instead. */
+class AffixExpander
+{
+public:
+  /*! \brief Load the rules from the affix file \a fileName.
+   * \param[out] error Description of the problem if the file could not be loaded.
+   * \return True if the file was loaded. */
+  bool loadAffixFile( const QString& fileName, QString* error );
+  /*! \brief Decode \a data from the encoding of the affix file. */
+  QString decode( const QByteArray& data ) const;
+  /*! \brief Characters from the TRY option of the affix file. */
+  QString tryCharacters() const;
+  /*! \brief Generate all forms of the dictionary entry \a line.
+   *
+   * The \a line is a line from the *.dic file, in the form "word/FLAGS"
+   * optionally followed by morphological fields. */
+  QStringList expand( const QString& line ) const;
+
+private:
+  struct AffixEntry
+  {
+    QString strip;
+    QString affix;
+    QRegularExpression condition;
+  };
+  struct AffixClass
+  {
+    bool isPrefix     = false;
+    bool crossProduct = false;
+    QVector<AffixEntry> entries;
+  };
+  enum class FlagType {
+    Short = 0,
+    Long,
+    Numeric,
+    Utf8
+  };
+
+  /*! \brief Split the \a flags of a dictionary entry, resolving aliases. */
+  QStringList parseFlags( const QString& flags ) const;
+  /*! \brief Split the \a flags according to the FLAG type. */
+  QStringList parseFlagString( const QString& flags ) const;
+  bool applies( const AffixEntry& entry, bool isPrefix, const QString& word ) const;
+  QString apply( const AffixEntry& entry, bool isPrefix, const QString& word ) const;
+
+  QByteArray d_encoding = "ISO-8859-1";
+  QString d_tryCharacters;
+  FlagType d_flagType = FlagType::Short;
+  QVector<QStringList> d_flagAliases;
+  QString d_needAffixFlag;
+  QString d_forbiddenFlag;
+  QString d_onlyInCompoundFlag;
+  QHash<QString, AffixClass> d_classes;
+};
+
+} // namespace DictionaryCompiler
+} // namespace SpellChecker
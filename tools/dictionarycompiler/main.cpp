@@ -0,0 +1,184 @@
+/**************************************************************************
+**
+** Copyright (c) 2014 Carel Combrink
+**
+** This file is part of the SpellChecker Plugin, a Qt Creator plugin.
+**
+** The SpellChecker Plugin is free software: you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3 of the
+** License, or (at your option) any later version.
+**
+** The SpellChecker Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with the SpellChecker Plugin.  If not, see <http://www.gnu.org/licenses/>.
+****************************************************************************/
+
+/*! \file
+ * \brief Compile a Hunspell dictionary into a word table for the SpellChecker.
+ *
+ * The compiled dictionary contains all words of the dictionary, expanded
+ * with their affixes, and can be memory mapped by the Compiled Dictionary
+ * spell checker of the plugin. Example:
+ *
+ *   spellchecker-dictionary-compiler --dic en_US.dic -o en_US.spcdict
+ *
+ * For dictionaries that rely on affix features that the compiler does not
+ * support, the word list can be expanded with the Hunspell unmunch tool:
+ *
+ *   unmunch en_US.dic en_US.aff > en_US.txt
+ *   spellchecker-dictionary-compiler --expanded en_US.txt --aff en_US.aff -o en_US.spcdict */
+
+#include "affixexpander.h"
+
+#include "../../src/SpellCheckers/CompiledDictionaryChecker/wordtable.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QVector>
+
+#include <utility>
+
+using namespace SpellChecker::DictionaryCompiler;
+using SpellChecker::Checker::CompiledDictionary::WordTable;
+using SpellChecker::Checker::CompiledDictionary::WordTableBuilder;
+
+namespace {
+/*! \brief Read the lines of \a fileName.
+ *
+ * Files of the dictionary are decoded using the encoding of the affix file,
+ * if no \a expander is given the file is read as UTF-8. */
+bool readLines( const QString& fileName, const AffixExpander* expander, QStringList& lines )
+{
+  QFile file( fileName );
+  if( file.open( QIODevice::ReadOnly ) == false ) {
+    qCritical().noquote() << "Could not open" << fileName << ":" << file.errorString();
+    return false;
+  }
+  const QByteArray data = file.readAll();
+  lines = ( ( expander != nullptr ) ? expander->decode( data ) : QString::fromUtf8( data ) ).split( QLatin1Char( '\n' ) );
+  for( QString& line: lines ) {
+    if( line.endsWith( QLatin1Char( '\r' ) ) == true ) {
+      line.chop( 1 );
+    }
+  }
+  return true;
+}
+// --------------------------------------------------
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+  QCoreApplication app( argc, argv );
+  QCoreApplication::setApplicationName( QStringLiteral( "spellchecker-dictionary-compiler" ) );
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription( QStringLiteral( "Compile a Hunspell dictionary into a memory mappable dictionary for the SpellChecker plugin." ) );
+  parser.addHelpOption();
+  const QCommandLineOption dicOption( QStringLiteral( "dic" ), QStringLiteral( "Hunspell dictionary (*.dic) to compile." ), QStringLiteral( "file" ) );
+  const QCommandLineOption affOption( QStringLiteral( "aff" ), QStringLiteral( "Hunspell affix file, by default the *.aff next to the dictionary." ), QStringLiteral( "file" ) );
+  const QCommandLineOption expandedOption( QStringLiteral( "expanded" ), QStringLiteral( "Already expanded word list, one word per line, for example from unmunch." ), QStringLiteral( "file" ) );
+  const QCommandLineOption userOption( QStringLiteral( "user" ), QStringLiteral( "Additional word list, one word per line. Can be given multiple times." ), QStringLiteral( "file" ) );
+  const QCommandLineOption outputOption( { QStringLiteral( "o" ), QStringLiteral( "output" ) }, QStringLiteral( "Compiled dictionary to write." ), QStringLiteral( "file" ) );
+  parser.addOptions( { dicOption, affOption, expandedOption, userOption, outputOption } );
+  parser.process( app );
+
+  if( ( parser.isSet( dicOption ) == false )
+      && ( parser.isSet( expandedOption ) == false ) ) {
+    qCritical().noquote() << "Either --dic or --expanded must be given.";
+    parser.showHelp( 1 );
+  }
+
+  QString affFileName = parser.value( affOption );
+  if( ( affFileName.isEmpty() == true )
+      && ( parser.isSet( dicOption ) == true ) ) {
+    affFileName = parser.value( dicOption );
+    affFileName.replace( QRegularExpression( QStringLiteral( "\\.dic$" ) ), QStringLiteral( ".aff" ) );
+  }
+  QString outputFileName = parser.value( outputOption );
+  if( outputFileName.isEmpty() == true ) {
+    const QString input = parser.isSet( dicOption ) ? parser.value( dicOption ) : parser.value( expandedOption );
+    const QFileInfo inputInfo( input );
+    outputFileName = inputInfo.path() + QLatin1Char( '/' ) + inputInfo.completeBaseName() + QStringLiteral( ".spcdict" );
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  AffixExpander expander;
+  if( affFileName.isEmpty() == false ) {
+    QString error;
+    if( expander.loadAffixFile( affFileName, &error ) == false ) {
+      qCritical().noquote() << "Could not load" << affFileName << ":" << error;
+      return 1;
+    }
+  }
+
+  WordTableBuilder builder;
+  builder.setTryCharacters( expander.tryCharacters() );
+
+  QStringList lines;
+  if( parser.isSet( dicOption ) == true ) {
+    if( readLines( parser.value( dicOption ), &expander, lines ) == false ) {
+      return 1;
+    }
+    /* The first line of the dictionary is the approximate number of words. */
+    for( qsizetype index = 1; index < lines.size(); ++index ) {
+      const QStringList forms = expander.expand( lines.at( index ) );
+      for( const QString& form: forms ) {
+        builder.addWord( form );
+      }
+    }
+  }
+  /* The expanded list is in the encoding of the dictionary, the user word
+   * lists are UTF-8 like the user dictionaries of the plugin. */
+  QVector<std::pair<QString, const AffixExpander*>> wordLists;
+  if( parser.isSet( expandedOption ) == true ) {
+    wordLists.append( { parser.value( expandedOption ), &expander } );
+  }
+  const QStringList userWordLists = parser.values( userOption );
+  for( const QString& userWordList: userWordLists ) {
+    wordLists.append( { userWordList, nullptr } );
+  }
+  for( const auto& wordList: std::as_const( wordLists ) ) {
+    if( readLines( wordList.first, wordList.second, lines ) == false ) {
+      return 1;
+    }
+    for( const QString& line: std::as_const( lines ) ) {
+      const QString word = line.trimmed();
+      if( word.isEmpty() == false ) {
+        builder.addWord( word );
+      }
+    }
+  }
+
+  const QByteArray table = builder.build();
+  /* Make sure that the plugin will accept the result. */
+  WordTable check;
+  QString error;
+  if( check.setData( reinterpret_cast<const uchar*>( table.constData() ), table.size(), &error ) == false ) {
+    qCritical().noquote() << "Compiled dictionary is not valid:" << error;
+    return 1;
+  }
+
+  QFile output( outputFileName );
+  if( ( output.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
+      || ( output.write( table ) != table.size() ) ) {
+    qCritical().noquote() << "Could not write" << outputFileName << ":" << output.errorString();
+    return 1;
+  }
+  output.close();
+
+  QTextStream( stdout ) << "Compiled " << builder.wordCount() << " words into " << outputFileName
+                        << " (" << table.size() << " bytes) in " << timer.elapsed() << " ms" << Qt::endl;
+  return 0;
+}